@@ -1,7 +1,17 @@
 #include "glm_vulkan.h"
 
+// Only instrumented builds need `glm_vulkan_instrumentation.h`, so copying
+// `glm_vulkan.h` and `glm_vulkan.cpp` into a project is enough otherwise.
+#ifdef GLM_VULKAN_ENABLE_INSTRUMENTATION
+#include "glm_vulkan_instrumentation.h"
+#else
+#define GLM_VULKAN_INSTRUMENT(function, elements) ((void)0)
+#endif
+
 
 glm::mat4x4 glm_vulkan::perspective_fov(float fovyRadians, float aspectRatio, float near, float far) {
+    GLM_VULKAN_INSTRUMENT(InstrumentedFunction::PERSPECTIVE_FOV, 1);
+
     float range = (1.0f / glm::tan(fovyRadians * 0.5f)) * near;
 
     float c0r0 = near / (range * aspectRatio);
@@ -33,6 +43,8 @@ glm::mat4x4 glm_vulkan::perspective_fov(float fovyRadians, float aspectRatio, fl
 }
 
 glm::mat4x4 glm_vulkan::perspective_frustum(float left, float right, float bottom, float top, float near, float far) {
+    GLM_VULKAN_INSTRUMENT(InstrumentedFunction::PERSPECTIVE_FRUSTUM, 1);
+
     float c0r0 = (2.0f * near) / (right - left);
     float c0r1 = 0.0f;
     float c0r2 = 0.0f;
@@ -62,6 +74,8 @@ glm::mat4x4 glm_vulkan::perspective_frustum(float left, float right, float botto
 }
 
 glm::mat4x4 glm_vulkan::orthographic_frustum(float left, float right, float bottom, float top, float near, float far) {
+    GLM_VULKAN_INSTRUMENT(InstrumentedFunction::ORTHOGRAPHIC_FRUSTUM, 1);
+
     float c0r0 = 2.0f / (right - left);
     float c0r1 = 0.0f;
     float c0r2 = 0.0f;
@@ -0,0 +1,171 @@
+#include "glm_vulkan_depth_precision.h"
+#include "glm_vulkan.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+
+namespace {
+    struct DepthCandidate {
+        glm_vulkan::DepthFormat format;
+        bool reversedZ;
+    };
+
+    constexpr DepthCandidate DEPTH_CANDIDATES[] = {
+        { glm_vulkan::DepthFormat::D16_UNORM,  false },
+        { glm_vulkan::DepthFormat::D24_UNORM,  false },
+        { glm_vulkan::DepthFormat::D32_SFLOAT, true  },
+        { glm_vulkan::DepthFormat::D32_SFLOAT, false }
+    };
+
+    // Only the depth rows of the projection matter to the analysis, so the
+    // horizontal and vertical extents are arbitrary.
+    glm::mat4x4 depth_projection(glm_vulkan::ProjectionKind kind, float near, float far) {
+        if (kind == glm_vulkan::ProjectionKind::PERSPECTIVE) {
+            return glm_vulkan::perspective_fov(glm::pi<float>() / 2.0f, 1.0f, near, far);
+        } else {
+            return glm_vulkan::orthographic_frustum(-1.0f, 1.0f, 1.0f, -1.0f, near, far);
+        }
+    }
+
+    // The distance from `value` to the next larger single precision float.
+    double float_step(double value) {
+        float magnitude = static_cast<float>(std::fabs(value));
+        return static_cast<double>(std::nextafter(magnitude, std::numeric_limits<float>::infinity())) -
+            static_cast<double>(magnitude);
+    }
+
+    bool meets_targets(
+        glm_vulkan::ProjectionKind kind,
+        float near,
+        float far,
+        const DepthCandidate& candidate,
+        const std::vector<glm_vulkan::DepthPrecisionTarget>& targets
+    ) {
+        auto projection = depth_projection(kind, near, far);
+        for (const auto& target : targets) {
+            double resolution = glm_vulkan::depth_resolution(
+                projection, target.eyeDepth, candidate.format, candidate.reversedZ
+            );
+            if (!(resolution <= static_cast<double>(target.maxResolution))) {
+                return false;
+            }
+        }
+
+        return true;
+    }
+}
+
+const char* glm_vulkan::depth_format_name(DepthFormat format) {
+    switch (format) {
+        case DepthFormat::D16_UNORM: return "D16_UNORM";
+        case DepthFormat::D24_UNORM: return "X8_D24_UNORM_PACK32";
+        case DepthFormat::D32_SFLOAT: return "D32_SFLOAT";
+    }
+
+    return "UNKNOWN";
+}
+
+std::size_t glm_vulkan::depth_format_bytes(DepthFormat format) {
+    switch (format) {
+        case DepthFormat::D16_UNORM: return 2;
+        case DepthFormat::D24_UNORM: return 4;
+        case DepthFormat::D32_SFLOAT: return 4;
+    }
+
+    return 0;
+}
+
+double glm_vulkan::depth_resolution(const glm::mat4x4& projection, float eyeDepth, DepthFormat format, bool reversedZ) {
+    double a = projection[2][2];
+    double b = projection[3][2];
+    double c = projection[2][3];
+    double e = projection[3][3];
+    double z = eyeDepth;
+
+    double denominator = c * z + e;
+    double depth = (a * z + b) / denominator;
+    double slope = std::fabs((a * e - b * c) / (denominator * denominator));
+    if (slope == 0.0) {
+        return std::numeric_limits<double>::infinity();
+    }
+
+    double stored = reversedZ ? 1.0 - depth : depth;
+    double step = 0.0;
+    switch (format) {
+        case DepthFormat::D16_UNORM: {
+            step = 1.0 / 65535.0;
+            break;
+        }
+        case DepthFormat::D24_UNORM: {
+            step = 1.0 / 16777215.0;
+            break;
+        }
+        case DepthFormat::D32_SFLOAT: {
+            // Nothing above `1` is ever stored, so the step at `1` is the one below it.
+            float value = static_cast<float>(std::min(std::max(stored, 0.0), 1.0));
+            if (value == 1.0f) {
+                step = 1.0 - static_cast<double>(std::nextafter(1.0f, 0.0f));
+            } else {
+                step = float_step(value);
+            }
+            break;
+        }
+    }
+
+    // The depth is computed in single precision as `(a * z + b) / w` before it is
+    // stored. Near a stored depth of `0` the two terms cancel, so the rounding of
+    // the larger term bounds the step from below. A reversed projection has the
+    // depth row `(c - a, e - b)`.
+    double depthA = reversedZ ? c - a : a;
+    double depthB = reversedZ ? e - b : b;
+    double arithmeticStep = std::max(float_step(depthA * z), float_step(depthB)) / std::fabs(denominator);
+    step = std::max(step, arithmeticStep);
+
+    return step / slope;
+}
+
+glm_vulkan::DepthFormatRecommendation glm_vulkan::recommend_depth_format(
+    ProjectionKind kind,
+    float near,
+    float far,
+    float maxNear,
+    const std::vector<DepthPrecisionTarget>& targets
+) {
+    // The near plane must not clip any of the targets.
+    float farthestNear = maxNear;
+    for (const auto& target : targets) {
+        farthestNear = std::min(farthestNear, target.eyeDepth);
+    }
+    farthestNear = std::max(farthestNear, near);
+
+    for (const auto& candidate : DEPTH_CANDIDATES) {
+        if (meets_targets(kind, near, far, candidate, targets)) {
+            return DepthFormatRecommendation { candidate.format, candidate.reversedZ, near, true };
+        }
+        if (!meets_targets(kind, farthestNear, far, candidate, targets)) {
+            continue;
+        }
+
+        // Keep `upper` meeting the targets and `lower` failing them.
+        float lower = near;
+        float upper = farthestNear;
+        for (std::size_t i = 0; i < 32; i++) {
+            float middle = 0.5f * (lower + upper);
+            if (middle <= lower || middle >= upper) {
+                break;
+            }
+
+            if (meets_targets(kind, middle, far, candidate, targets)) {
+                upper = middle;
+            } else {
+                lower = middle;
+            }
+        }
+
+        return DepthFormatRecommendation { candidate.format, candidate.reversedZ, upper, true };
+    }
+
+    return DepthFormatRecommendation { DepthFormat::D32_SFLOAT, true, farthestNear, false };
+}
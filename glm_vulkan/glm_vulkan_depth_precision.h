@@ -0,0 +1,129 @@
+#ifndef _GLM_VULKAN_DEPTH_PRECISION_H
+#define _GLM_VULKAN_DEPTH_PRECISION_H
+
+#include <glm/mat4x4.hpp>
+
+#include <cstddef>
+#include <vector>
+
+
+namespace glm_vulkan {
+    /// @brief The Vulkan depth attachment formats covered by the depth precision
+    /// analysis, ordered from cheapest to most expensive.
+    ///
+    /// @details `D24_UNORM` stands for the packed format `X8_D24_UNORM_PACK32`,
+    /// which has the same depth precision as the depth aspect of
+    /// `D24_UNORM_S8_UINT`.
+    enum class DepthFormat {
+        D16_UNORM,
+        D24_UNORM,
+        D32_SFLOAT
+    };
+
+    /// @brief The family of projection matrix a depth range is analyzed for.
+    ///
+    /// @details `PERSPECTIVE` covers both `perspective_fov` and `perspective_frustum`,
+    /// which share the same depth mapping. `ORTHOGRAPHIC` covers `orthographic_frustum`.
+    enum class ProjectionKind {
+        PERSPECTIVE,
+        ORTHOGRAPHIC
+    };
+
+    /// @brief A requirement on the depth resolution at one eye space distance.
+    struct DepthPrecisionTarget {
+        /// @brief The eye space distance along the `positive z-axis`.
+        float eyeDepth;
+        /// @brief The largest acceptable eye space distance between two
+        /// neighboring representable depth values at `eyeDepth`.
+        float maxResolution;
+    };
+
+    /// @brief The result of `recommend_depth_format`.
+    struct DepthFormatRecommendation {
+        /// @brief The cheapest depth format meeting every target.
+        DepthFormat format;
+        /// @brief Whether the format must be used with reversed-Z, mapping the near
+        /// plane to depth `1` and the far plane to depth `0`.
+        bool reversedZ;
+        /// @brief The suggested near plane distance.
+        float near;
+        /// @brief Whether the targets are met. When no format meets the targets,
+        /// the recommendation is the most precise configuration available.
+        bool satisfied;
+    };
+
+    /// @brief The name of a depth format as spelled in the Vulkan API, without the
+    /// `VK_FORMAT_` prefix. `D24_UNORM` is named `X8_D24_UNORM_PACK32`.
+    const char* depth_format_name(DepthFormat format);
+
+    /// @brief The number of bytes per texel of a depth format, counting the padding
+    /// of `X8_D24_UNORM_PACK32`.
+    std::size_t depth_format_bytes(DepthFormat format);
+
+    /// @brief Compute the eye space depth resolution of a projection at an eye
+    /// space distance.
+    ///
+    /// @details The normalized device depth of a point at eye space distance `z` is
+    /// `d(z) == (m[2, 2] * z + m[3, 2]) / (m[2, 3] * z + m[3, 3])`. With
+    /// reversed-Z the stored depth is `1 - d(z)`, as produced by swapping the near
+    /// and far planes in the projection. The resolution is the eye space distance
+    /// covered by one step of the stored depth value at `d(z)`, that is
+    ///
+    /// @code{.unparsed}
+    /// resolution(z) == step(d(z)) / |d'(z)|
+    /// @endcode
+    ///
+    /// where `step` is `1 / (2^16 - 1)` for `D16_UNORM`, `1 / (2^24 - 1)` for
+    /// `D24_UNORM`, and the distance to the neighboring representable single
+    /// precision float in `[0, 1]` for `D32_SFLOAT`. Smaller values are more
+    /// precise. Because the depth is computed in single precision before it is
+    /// stored, `step` is bounded from below by one single precision step of the
+    /// larger of the terms `m[2, 2] * z` and `m[3, 2]`, divided by `w`. This keeps
+    /// the resolution finite where the stored depth is `0`, at the near plane, or
+    /// at the far plane with reversed-Z.
+    ///
+    /// @section Parameters
+    /// @param projection a projection matrix built with `perspective_fov`,
+    /// `perspective_frustum`, or `orthographic_frustum`.
+    /// @param eyeDepth the eye space distance along the `positive z-axis`.
+    /// @param format the depth attachment format.
+    /// @param reversedZ whether the depth is stored reversed.
+    ///
+    /// @return the eye space depth resolution at `eyeDepth`.
+    double depth_resolution(const glm::mat4x4& projection, float eyeDepth, DepthFormat format, bool reversedZ);
+
+    /// @brief Find the cheapest depth format and the near plane meeting a target
+    /// depth resolution curve.
+    ///
+    /// @details The candidates are tried from cheapest to most expensive:
+    /// `D16_UNORM`, `D24_UNORM`, reversed-Z `D32_SFLOAT`, and `D32_SFLOAT`.
+    /// Reversed-Z does not change the storage step of the UNORM formats, so they
+    /// are only tried with the conventional depth direction. Moving
+    /// the near plane out improves the resolution, dramatically so for perspective
+    /// projections, so each candidate is also tried with the near plane pushed out
+    /// as far as `maxNear`, or as far as the closest target, whichever is nearer.
+    /// The suggested near plane is then found by bisection between the configured
+    /// near plane and that bound.
+    ///
+    /// @pre 0 < near <= maxNear < far
+    /// @pre every target satisfies near <= eyeDepth <= far
+    ///
+    /// @section Parameters
+    /// @param kind the family of the projection matrix.
+    /// @param near the configured near plane distance.
+    /// @param far the far plane distance.
+    /// @param maxNear the farthest acceptable near plane distance. Pass `near` to
+    /// keep the near plane fixed.
+    /// @param targets the target depth resolution curve.
+    ///
+    /// @return the recommended depth format configuration.
+    DepthFormatRecommendation recommend_depth_format(
+        ProjectionKind kind,
+        float near,
+        float far,
+        float maxNear,
+        const std::vector<DepthPrecisionTarget>& targets
+    );
+}
+
+#endif // _GLM_VULKAN_DEPTH_PRECISION_H
@@ -0,0 +1,233 @@
+#include "glm_vulkan_instrumentation.h"
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+
+namespace {
+    struct AtomicCounters {
+        std::atomic<std::uint64_t> calls { 0 };
+        std::atomic<std::uint64_t> elements { 0 };
+        std::atomic<std::uint64_t> accepted { 0 };
+        std::atomic<std::uint64_t> culled { 0 };
+        std::atomic<std::uint64_t> nanoseconds { 0 };
+    };
+
+    struct TraceEvent {
+        glm_vulkan::InstrumentedFunction function;
+        std::uint64_t elements;
+        std::chrono::steady_clock::time_point start;
+        std::chrono::steady_clock::duration duration;
+    };
+
+    // The counters of one thread. Only the owning thread writes the counters, so
+    // it updates them with plain relaxed loads and stores instead of atomic
+    // read-modify-write instructions. The block outlives its thread and is handed
+    // to the next new thread, so the counters only ever grow.
+    struct ThreadBlock {
+        std::array<AtomicCounters, glm_vulkan::INSTRUMENTED_FUNCTION_COUNT> counters;
+        std::uint32_t threadIndex = 0;
+        bool inUse = false;
+        std::mutex traceMutex;
+        std::vector<TraceEvent> traceEvents;
+    };
+
+    struct Registry {
+        std::mutex mutex;
+        std::vector<std::unique_ptr<ThreadBlock>> blocks;
+        glm_vulkan::InstrumentationSnapshot baseline {};
+        std::atomic<bool> tracing { false };
+        std::chrono::steady_clock::time_point epoch = std::chrono::steady_clock::now();
+    };
+
+    Registry& registry() {
+        static Registry instance;
+        return instance;
+    }
+
+    ThreadBlock* acquire_block() {
+        auto& instance = registry();
+        std::lock_guard<std::mutex> lock { instance.mutex };
+        for (auto& block : instance.blocks) {
+            if (!block->inUse) {
+                block->inUse = true;
+                return block.get();
+            }
+        }
+
+        auto block = std::make_unique<ThreadBlock>();
+        block->threadIndex = static_cast<std::uint32_t>(instance.blocks.size());
+        block->inUse = true;
+        instance.blocks.push_back(std::move(block));
+
+        return instance.blocks.back().get();
+    }
+
+    struct ThreadHandle {
+        ThreadBlock* block = acquire_block();
+
+        ~ThreadHandle() {
+            std::lock_guard<std::mutex> lock { registry().mutex };
+            block->inUse = false;
+        }
+    };
+
+    ThreadBlock& thread_block() {
+        thread_local ThreadHandle handle;
+        return *handle.block;
+    }
+
+    void add(std::atomic<std::uint64_t>& counter, std::uint64_t value) {
+        counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+    }
+
+    // Sum the counters of every thread. Must be called with the registry locked.
+    glm_vulkan::InstrumentationSnapshot sum_counters(const Registry& instance) {
+        glm_vulkan::InstrumentationSnapshot total {};
+        for (const auto& block : instance.blocks) {
+            for (std::size_t i = 0; i < glm_vulkan::INSTRUMENTED_FUNCTION_COUNT; i++) {
+                const auto& source = block->counters[i];
+                auto& target = total.functions[i];
+                target.calls += source.calls.load(std::memory_order_relaxed);
+                target.elements += source.elements.load(std::memory_order_relaxed);
+                target.accepted += source.accepted.load(std::memory_order_relaxed);
+                target.culled += source.culled.load(std::memory_order_relaxed);
+                target.nanoseconds += source.nanoseconds.load(std::memory_order_relaxed);
+            }
+        }
+
+        return total;
+    }
+
+    // Write a duration as microseconds with three decimals from its integer
+    // nanosecond count. Formatting it as a `double` would switch to exponent
+    // notation, and lose precision, once a trace runs longer than a second.
+    void write_microseconds(std::ostream& out, std::chrono::steady_clock::duration duration) {
+        auto nanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count();
+        if (nanoseconds < 0) {
+            out << '-';
+            nanoseconds = -nanoseconds;
+        }
+
+        auto fraction = nanoseconds % 1000;
+        char digits[4] = {
+            static_cast<char>('0' + fraction / 100),
+            static_cast<char>('0' + fraction / 10 % 10),
+            static_cast<char>('0' + fraction % 10),
+            '\0'
+        };
+        out << nanoseconds / 1000 << '.' << digits;
+    }
+}
+
+const char* glm_vulkan::instrumented_function_name(InstrumentedFunction function) {
+    switch (function) {
+        case InstrumentedFunction::PERSPECTIVE_FOV: return "perspective_fov";
+        case InstrumentedFunction::PERSPECTIVE_FRUSTUM: return "perspective_frustum";
+        case InstrumentedFunction::ORTHOGRAPHIC_FRUSTUM: return "orthographic_frustum";
+        case InstrumentedFunction::OCCLUSION_ADD_OCCLUDER: return "OcclusionBuffer::add_occluder";
+        case InstrumentedFunction::OCCLUSION_RASTERIZE: return "OcclusionBuffer::rasterize";
+        case InstrumentedFunction::OCCLUSION_TEST_AABBS: return "OcclusionBuffer::test_aabbs";
+        case InstrumentedFunction::CULL_SPHERES: return "cull_spheres";
+        case InstrumentedFunction::CULL_AABBS: return "cull_aabbs";
+        case InstrumentedFunction::COUNT: break;
+    }
+
+    return "unknown";
+}
+
+glm_vulkan::InstrumentationSnapshot glm_vulkan::instrumentation_snapshot(bool reset) {
+    auto& instance = registry();
+    std::lock_guard<std::mutex> lock { instance.mutex };
+    auto total = sum_counters(instance);
+    InstrumentationSnapshot snapshot {};
+    for (std::size_t i = 0; i < INSTRUMENTED_FUNCTION_COUNT; i++) {
+        const auto& current = total.functions[i];
+        const auto& baseline = instance.baseline.functions[i];
+        snapshot.functions[i] = InstrumentationCounters {
+            current.calls - baseline.calls,
+            current.elements - baseline.elements,
+            current.accepted - baseline.accepted,
+            current.culled - baseline.culled,
+            current.nanoseconds - baseline.nanoseconds
+        };
+    }
+
+    if (reset) {
+        instance.baseline = total;
+    }
+
+    return snapshot;
+}
+
+void glm_vulkan::reset_instrumentation() {
+    auto& instance = registry();
+    std::lock_guard<std::mutex> lock { instance.mutex };
+    instance.baseline = sum_counters(instance);
+}
+
+void glm_vulkan::set_instrumentation_tracing(bool enabled) {
+    registry().tracing.store(enabled, std::memory_order_relaxed);
+}
+
+void glm_vulkan::write_chrome_trace(std::ostream& out) {
+    auto& instance = registry();
+    std::lock_guard<std::mutex> lock { instance.mutex };
+    out << "{\"traceEvents\":[";
+    bool first = true;
+    for (auto& block : instance.blocks) {
+        std::vector<TraceEvent> events;
+        {
+            std::lock_guard<std::mutex> traceLock { block->traceMutex };
+            events.swap(block->traceEvents);
+        }
+
+        for (const auto& event : events) {
+            out << (first ? "" : ",")
+                << "{\"name\":\"" << instrumented_function_name(event.function) << "\""
+                << ",\"cat\":\"glm_vulkan\",\"ph\":\"X\""
+                << ",\"ts\":";
+            write_microseconds(out, event.start - instance.epoch);
+            out << ",\"dur\":";
+            write_microseconds(out, event.duration);
+            out << ",\"pid\":0,\"tid\":" << block->threadIndex
+                << ",\"args\":{\"elements\":" << event.elements << "}}";
+            first = false;
+        }
+    }
+    out << "]}";
+}
+
+glm_vulkan::InstrumentationScope::InstrumentationScope(InstrumentedFunction function, std::uint64_t elements)
+    : m_function(function)
+    , m_elements(elements)
+    , m_accepted(0)
+    , m_culled(0)
+    , m_start(std::chrono::steady_clock::now())
+{
+}
+
+glm_vulkan::InstrumentationScope::~InstrumentationScope() {
+    auto duration = std::chrono::steady_clock::now() - m_start;
+    auto& block = thread_block();
+    auto& counters = block.counters[static_cast<std::size_t>(m_function)];
+    add(counters.calls, 1);
+    add(counters.elements, m_elements);
+    add(counters.accepted, m_accepted);
+    add(counters.culled, m_culled);
+    add(counters.nanoseconds, static_cast<std::uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count()
+    ));
+
+    if (registry().tracing.load(std::memory_order_relaxed)) {
+        std::lock_guard<std::mutex> lock { block.traceMutex };
+        block.traceEvents.push_back(TraceEvent { m_function, m_elements, m_start, duration });
+    }
+}
+
+void glm_vulkan::InstrumentationScope::record_culling(std::uint64_t accepted, std::uint64_t culled) {
+    m_accepted += accepted;
+    m_culled += culled;
+}
@@ -0,0 +1,131 @@
+#ifndef _GLM_VULKAN_INSTRUMENTATION_H
+#define _GLM_VULKAN_INSTRUMENTATION_H
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+
+
+namespace glm_vulkan {
+    /// @brief The library functions that record instrumentation counters.
+    enum class InstrumentedFunction {
+        PERSPECTIVE_FOV,
+        PERSPECTIVE_FRUSTUM,
+        ORTHOGRAPHIC_FRUSTUM,
+        OCCLUSION_ADD_OCCLUDER,
+        OCCLUSION_RASTERIZE,
+        OCCLUSION_TEST_AABBS,
+        CULL_SPHERES,
+        CULL_AABBS,
+        COUNT
+    };
+
+    /// @brief The number of instrumented functions.
+    constexpr std::size_t INSTRUMENTED_FUNCTION_COUNT = static_cast<std::size_t>(InstrumentedFunction::COUNT);
+
+    /// @brief The counters accumulated for one instrumented function.
+    struct InstrumentationCounters {
+        /// @brief The number of calls.
+        std::uint64_t calls;
+        /// @brief The number of elements processed: matrices built, occluder
+        /// triangles, or bounding volumes tested.
+        std::uint64_t elements;
+        /// @brief The number of bounding volumes reported as possibly visible.
+        std::uint64_t accepted;
+        /// @brief The number of bounding volumes culled.
+        std::uint64_t culled;
+        /// @brief The total time spent inside the function in nanoseconds.
+        std::uint64_t nanoseconds;
+    };
+
+    /// @brief The counters of every instrumented function summed over all threads.
+    struct InstrumentationSnapshot {
+        std::array<InstrumentationCounters, INSTRUMENTED_FUNCTION_COUNT> functions;
+
+        const InstrumentationCounters& operator[](InstrumentedFunction function) const {
+            return functions[static_cast<std::size_t>(function)];
+        }
+    };
+
+    /// @brief Whether the library was compiled with instrumentation.
+    ///
+    /// @details Instrumentation is enabled by building with the CMake option
+    /// `glm_vulkan_ENABLE_INSTRUMENTATION`, which defines the preprocessor symbol
+    /// `GLM_VULKAN_ENABLE_INSTRUMENTATION`. Without it, the instrumentation points
+    /// expand to nothing, snapshots are all zeros, and traces are empty.
+    constexpr bool instrumentation_enabled() {
+#ifdef GLM_VULKAN_ENABLE_INSTRUMENTATION
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    /// @brief The name of an instrumented function, as used in trace events.
+    const char* instrumented_function_name(InstrumentedFunction function);
+
+    /// @brief Sum the counters of every thread since the last reset.
+    ///
+    /// @details Each thread accumulates into its own counters without locking.
+    /// Taking a snapshot reads them concurrently, so counts from calls that are
+    /// still in flight may be partially included.
+    ///
+    /// @section Parameters
+    /// @param reset whether to start a new measurement interval at the snapshot,
+    /// as if `reset_instrumentation` were called at the same instant.
+    ///
+    /// @return the counters accumulated since the last reset.
+    InstrumentationSnapshot instrumentation_snapshot(bool reset = false);
+
+    /// @brief Start a new measurement interval for `instrumentation_snapshot`.
+    void reset_instrumentation();
+
+    /// @brief Enable or disable recording trace events.
+    ///
+    /// @details While tracing is enabled, every instrumented call also records a
+    /// trace event into a buffer owned by the calling thread. Tracing is disabled
+    /// by default.
+    void set_instrumentation_tracing(bool enabled);
+
+    /// @brief Write the buffered trace events in the Chrome trace event JSON format
+    /// and discard them.
+    ///
+    /// @details The output can be loaded by `chrome://tracing` and Perfetto.
+    void write_chrome_trace(std::ostream& out);
+
+    /// @brief Records one instrumented call from construction to destruction.
+    ///
+    /// @details Used by the library through `GLM_VULKAN_INSTRUMENT`. The
+    /// counters are updated once, when the scope ends.
+    class InstrumentationScope {
+    public:
+        InstrumentationScope(InstrumentedFunction function, std::uint64_t elements);
+        ~InstrumentationScope();
+
+        InstrumentationScope(const InstrumentationScope&) = delete;
+        InstrumentationScope& operator=(const InstrumentationScope&) = delete;
+
+        void record_culling(std::uint64_t accepted, std::uint64_t culled);
+
+    private:
+        InstrumentedFunction m_function;
+        std::uint64_t m_elements;
+        std::uint64_t m_accepted;
+        std::uint64_t m_culled;
+        std::chrono::steady_clock::time_point m_start;
+    };
+}
+
+#ifdef GLM_VULKAN_ENABLE_INSTRUMENTATION
+#define GLM_VULKAN_INSTRUMENT(function, elements) \
+    ::glm_vulkan::InstrumentationScope glm_vulkan_instrumentation_scope { (function), (elements) }
+#define GLM_VULKAN_INSTRUMENT_CULLING(accepted, culled) \
+    glm_vulkan_instrumentation_scope.record_culling((accepted), (culled))
+#else
+#define GLM_VULKAN_INSTRUMENT(function, elements) ((void)0)
+#define GLM_VULKAN_INSTRUMENT_CULLING(accepted, culled) ((void)0)
+#endif
+
+#endif // _GLM_VULKAN_INSTRUMENTATION_H
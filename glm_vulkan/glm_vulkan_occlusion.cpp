@@ -0,0 +1,386 @@
+#include "glm_vulkan_occlusion.h"
+
+#include <algorithm>
+#include <cmath>
+
+#ifdef GLM_VULKAN_ENABLE_INSTRUMENTATION
+#include "glm_vulkan_instrumentation.h"
+#else
+#define GLM_VULKAN_INSTRUMENT(function, elements) ((void)0)
+#define GLM_VULKAN_INSTRUMENT_CULLING(accepted, culled) ((void)0)
+#endif
+
+
+glm_vulkan::OcclusionBuffer::OcclusionBuffer(std::size_t width, std::size_t height)
+    : m_width(width)
+    , m_height(height)
+    , m_tilesX((width + TILE_SIZE - 1) / TILE_SIZE)
+    , m_tilesY((height + TILE_SIZE - 1) / TILE_SIZE)
+{
+    std::size_t levelWidth = m_tilesX * TILE_SIZE;
+    std::size_t levelHeight = m_tilesY * TILE_SIZE;
+    while (true) {
+        m_levelWidths.push_back(levelWidth);
+        m_levelHeights.push_back(levelHeight);
+        m_levels.emplace_back(levelWidth * levelHeight, 1.0f);
+        if (levelWidth == 1 && levelHeight == 1) {
+            break;
+        }
+
+        levelWidth = (levelWidth + 1) / 2;
+        levelHeight = (levelHeight + 1) / 2;
+    }
+
+    m_bins.resize(m_tilesX * m_tilesY);
+    this->clear();
+}
+
+std::size_t glm_vulkan::OcclusionBuffer::width() const {
+    return m_width;
+}
+
+std::size_t glm_vulkan::OcclusionBuffer::height() const {
+    return m_height;
+}
+
+void glm_vulkan::OcclusionBuffer::clear() {
+    // The padding pixels past the right and bottom edges of the viewport hold
+    // depth `0`, so they never raise the farthest depth of the coarser texels
+    // overlapping the edges. Occludee footprints never reach the padding itself.
+    auto& pixels = m_levels[0];
+    std::size_t pitch = m_levelWidths[0];
+    std::fill(pixels.begin(), pixels.end(), 0.0f);
+    for (std::size_t y = 0; y < m_height; y++) {
+        std::fill_n(pixels.begin() + y * pitch, m_width, 1.0f);
+    }
+
+    for (std::size_t level = 1; level < m_levels.size(); level++) {
+        std::fill(m_levels[level].begin(), m_levels[level].end(), 1.0f);
+    }
+
+    for (auto& bin : m_bins) {
+        bin.clear();
+    }
+
+    m_triangles.clear();
+}
+
+void glm_vulkan::OcclusionBuffer::add_occluder(
+    const glm::vec3* vertices,
+    std::size_t vertexCount,
+    const std::uint32_t* indices,
+    std::size_t indexCount,
+    const glm::mat4x4& modelViewProjection
+) {
+    GLM_VULKAN_INSTRUMENT(InstrumentedFunction::OCCLUSION_ADD_OCCLUDER, indexCount / 3);
+
+    std::vector<glm::vec4> clipVertices(vertexCount);
+    for (std::size_t i = 0; i < vertexCount; i++) {
+        clipVertices[i] = modelViewProjection * glm::vec4 { vertices[i], 1.0f };
+    }
+
+    for (std::size_t i = 0; i + 2 < indexCount; i += 3) {
+        this->add_triangle(
+            clipVertices[indices[i]],
+            clipVertices[indices[i + 1]],
+            clipVertices[indices[i + 2]]
+        );
+    }
+}
+
+void glm_vulkan::OcclusionBuffer::add_triangle(const glm::vec4& v0, const glm::vec4& v1, const glm::vec4& v2) {
+    // Drop triangles crossing the near plane `z == 0` instead of clipping them.
+    // Losing an occluder can only make the culling less aggressive.
+    if (v0.w <= 0.0f || v1.w <= 0.0f || v2.w <= 0.0f) {
+        return;
+    }
+    if (v0.z < 0.0f || v1.z < 0.0f || v2.z < 0.0f) {
+        return;
+    }
+
+    // Trivially reject triangles lying entirely outside one of the clip planes.
+    if ((v0.x < -v0.w && v1.x < -v1.w && v2.x < -v2.w) ||
+        (v0.x >  v0.w && v1.x >  v1.w && v2.x >  v2.w) ||
+        (v0.y < -v0.w && v1.y < -v1.w && v2.y < -v2.w) ||
+        (v0.y >  v0.w && v1.y >  v1.w && v2.y >  v2.w) ||
+        (v0.z >  v0.w && v1.z >  v1.w && v2.z >  v2.w)
+    ) {
+        return;
+    }
+
+    // Map normalized device coordinates to the viewport. Clip space `y` already
+    // faces down, so it maps to rows without a flip.
+    float halfWidth = 0.5f * static_cast<float>(m_width);
+    float halfHeight = 0.5f * static_cast<float>(m_height);
+    float sx[3] = {
+        (v0.x / v0.w + 1.0f) * halfWidth,
+        (v1.x / v1.w + 1.0f) * halfWidth,
+        (v2.x / v2.w + 1.0f) * halfWidth
+    };
+    float sy[3] = {
+        (v0.y / v0.w + 1.0f) * halfHeight,
+        (v1.y / v1.w + 1.0f) * halfHeight,
+        (v2.y / v2.w + 1.0f) * halfHeight
+    };
+    float sz[3] = { v0.z / v0.w, v1.z / v1.w, v2.z / v2.w };
+
+    float area = (sx[1] - sx[0]) * (sy[2] - sy[0]) - (sx[2] - sx[0]) * (sy[1] - sy[0]);
+    if (std::fabs(area) < 1.0e-8f) {
+        return;
+    }
+    // Occluders are double-sided: reorder clockwise triangles so that the interior
+    // of every triangle is where all three edge functions are non-negative.
+    if (area < 0.0f) {
+        std::swap(sx[1], sx[2]);
+        std::swap(sy[1], sy[2]);
+        std::swap(sz[1], sz[2]);
+        area = -area;
+    }
+
+    float minSx = std::min({ sx[0], sx[1], sx[2] });
+    float maxSx = std::max({ sx[0], sx[1], sx[2] });
+    float minSy = std::min({ sy[0], sy[1], sy[2] });
+    float maxSy = std::max({ sy[0], sy[1], sy[2] });
+
+    // The range of pixels whose centers lie inside the bounding box, clamped to
+    // the viewport.
+    float lastX = static_cast<float>(m_width - 1);
+    float lastY = static_cast<float>(m_height - 1);
+    float minPx = std::max(std::ceil(minSx - 0.5f), 0.0f);
+    float maxPx = std::min(std::floor(maxSx - 0.5f), lastX);
+    float minPy = std::max(std::ceil(minSy - 0.5f), 0.0f);
+    float maxPy = std::min(std::floor(maxSy - 0.5f), lastY);
+    if (minPx > maxPx || minPy > maxPy) {
+        return;
+    }
+
+    Triangle triangle;
+    // The edge function of the edge from `a` to `b` is
+    // `E(x, y) == A * x + B * y + C`, which is positive to the right of the edge.
+    for (std::size_t edge = 0; edge < 3; edge++) {
+        std::size_t a = edge;
+        std::size_t b = (edge + 1) % 3;
+        triangle.edgeA[edge] = sy[a] - sy[b];
+        triangle.edgeB[edge] = sx[b] - sx[a];
+        triangle.edgeC[edge] = -triangle.edgeA[edge] * sx[a] - triangle.edgeB[edge] * sy[a];
+    }
+
+    // Depth in normalized device coordinates is affine in screen space. The
+    // barycentric weight of vertex `1` is the edge function of edge `2 -> 0`,
+    // and the weight of vertex `2` is the edge function of edge `0 -> 1`.
+    float dz1 = (sz[1] - sz[0]) / area;
+    float dz2 = (sz[2] - sz[0]) / area;
+    triangle.depthA = triangle.edgeA[2] * dz1 + triangle.edgeA[0] * dz2;
+    triangle.depthB = triangle.edgeB[2] * dz1 + triangle.edgeB[0] * dz2;
+    triangle.depthC = sz[0] + triangle.edgeC[2] * dz1 + triangle.edgeC[0] * dz2;
+
+    triangle.minX = static_cast<std::int32_t>(minPx);
+    triangle.maxX = static_cast<std::int32_t>(maxPx);
+    triangle.minY = static_cast<std::int32_t>(minPy);
+    triangle.maxY = static_cast<std::int32_t>(maxPy);
+
+    auto triangleIndex = static_cast<std::uint32_t>(m_triangles.size());
+    m_triangles.push_back(triangle);
+
+    std::size_t minTileX = static_cast<std::size_t>(triangle.minX) / TILE_SIZE;
+    std::size_t maxTileX = static_cast<std::size_t>(triangle.maxX) / TILE_SIZE;
+    std::size_t minTileY = static_cast<std::size_t>(triangle.minY) / TILE_SIZE;
+    std::size_t maxTileY = static_cast<std::size_t>(triangle.maxY) / TILE_SIZE;
+    for (std::size_t tileY = minTileY; tileY <= maxTileY; tileY++) {
+        for (std::size_t tileX = minTileX; tileX <= maxTileX; tileX++) {
+            m_bins[tileY * m_tilesX + tileX].push_back(triangleIndex);
+        }
+    }
+}
+
+void glm_vulkan::OcclusionBuffer::rasterize() {
+    GLM_VULKAN_INSTRUMENT(InstrumentedFunction::OCCLUSION_RASTERIZE, m_triangles.size());
+
+    this->rasterize_tile_range(0, this->tile_count());
+    this->build_hierarchy();
+}
+
+std::size_t glm_vulkan::OcclusionBuffer::tile_count() const {
+    return m_bins.size();
+}
+
+void glm_vulkan::OcclusionBuffer::rasterize_tile_range(std::size_t begin, std::size_t end) {
+    for (std::size_t tileIndex = begin; tileIndex < end; tileIndex++) {
+        this->rasterize_tile(tileIndex);
+    }
+}
+
+void glm_vulkan::OcclusionBuffer::rasterize_tile(std::size_t tileIndex) {
+    const auto& bin = m_bins[tileIndex];
+    if (bin.empty()) {
+        return;
+    }
+
+    std::size_t pitch = m_levelWidths[0];
+    std::int32_t tileX0 = static_cast<std::int32_t>((tileIndex % m_tilesX) * TILE_SIZE);
+    std::int32_t tileY0 = static_cast<std::int32_t>((tileIndex / m_tilesX) * TILE_SIZE);
+    std::int32_t tileX1 = tileX0 + static_cast<std::int32_t>(TILE_SIZE) - 1;
+    std::int32_t tileY1 = tileY0 + static_cast<std::int32_t>(TILE_SIZE) - 1;
+
+    float pixelX[TILE_SIZE];
+    for (std::size_t lane = 0; lane < TILE_SIZE; lane++) {
+        pixelX[lane] = static_cast<float>(tileX0) + static_cast<float>(lane) + 0.5f;
+    }
+
+    float* depths = m_levels[0].data();
+    for (auto triangleIndex : bin) {
+        const Triangle& triangle = m_triangles[triangleIndex];
+        std::int32_t minX = std::max(triangle.minX, tileX0);
+        std::int32_t maxX = std::min(triangle.maxX, tileX1);
+        std::int32_t minY = std::max(triangle.minY, tileY0);
+        std::int32_t maxY = std::min(triangle.maxY, tileY1);
+        float laneMinX = static_cast<float>(minX);
+        float laneMaxX = static_cast<float>(maxX) + 1.0f;
+
+        for (std::int32_t y = minY; y <= maxY; y++) {
+            float pixelY = static_cast<float>(y) + 0.5f;
+            float rowE0 = triangle.edgeB[0] * pixelY + triangle.edgeC[0];
+            float rowE1 = triangle.edgeB[1] * pixelY + triangle.edgeC[1];
+            float rowE2 = triangle.edgeB[2] * pixelY + triangle.edgeC[2];
+            float rowZ = triangle.depthB * pixelY + triangle.depthC;
+            float* row = depths + static_cast<std::size_t>(y) * pitch + static_cast<std::size_t>(tileX0);
+
+            // Evaluate the edge functions over a full tile row at once. The loop
+            // has a fixed trip count and no branches, which lets compilers
+            // vectorize it at high optimization levels such as `-O3`. It is not
+            // guaranteed to vectorize at lower levels.
+            for (std::size_t lane = 0; lane < TILE_SIZE; lane++) {
+                float x = pixelX[lane];
+                float e0 = triangle.edgeA[0] * x + rowE0;
+                float e1 = triangle.edgeA[1] * x + rowE1;
+                float e2 = triangle.edgeA[2] * x + rowE2;
+                float z = triangle.depthA * x + rowZ;
+                bool inside = (e0 >= 0.0f) & (e1 >= 0.0f) & (e2 >= 0.0f) &
+                    (x > laneMinX) & (x < laneMaxX) & (z < row[lane]);
+                row[lane] = inside ? z : row[lane];
+            }
+        }
+    }
+}
+
+void glm_vulkan::OcclusionBuffer::build_hierarchy() {
+    for (std::size_t level = 1; level < m_levels.size(); level++) {
+        const auto& source = m_levels[level - 1];
+        auto& target = m_levels[level];
+        std::size_t sourceWidth = m_levelWidths[level - 1];
+        std::size_t sourceHeight = m_levelHeights[level - 1];
+        std::size_t targetWidth = m_levelWidths[level];
+        std::size_t targetHeight = m_levelHeights[level];
+
+        for (std::size_t y = 0; y < targetHeight; y++) {
+            std::size_t y0 = 2 * y;
+            std::size_t y1 = std::min(y0 + 1, sourceHeight - 1);
+            for (std::size_t x = 0; x < targetWidth; x++) {
+                std::size_t x0 = 2 * x;
+                std::size_t x1 = std::min(x0 + 1, sourceWidth - 1);
+                target[y * targetWidth + x] = std::max(
+                    std::max(source[y0 * sourceWidth + x0], source[y0 * sourceWidth + x1]),
+                    std::max(source[y1 * sourceWidth + x0], source[y1 * sourceWidth + x1])
+                );
+            }
+        }
+    }
+}
+
+float glm_vulkan::OcclusionBuffer::depth(std::size_t x, std::size_t y) const {
+    return m_levels[0][y * m_levelWidths[0] + x];
+}
+
+bool glm_vulkan::OcclusionBuffer::is_visible(
+    const glm::vec3& aabbMin,
+    const glm::vec3& aabbMax,
+    const glm::mat4x4& modelViewProjection
+) const {
+    float minX =  1.0f;
+    float maxX = -1.0f;
+    float minY =  1.0f;
+    float maxY = -1.0f;
+    float minZ =  1.0f;
+    bool first = true;
+    for (std::size_t corner = 0; corner < 8; corner++) {
+        auto point = glm::vec4 {
+            (corner & 1) ? aabbMax.x : aabbMin.x,
+            (corner & 2) ? aabbMax.y : aabbMin.y,
+            (corner & 4) ? aabbMax.z : aabbMin.z,
+            1.0f
+        };
+        auto clipPoint = modelViewProjection * point;
+        // A box crossing the near plane cannot be bounded in screen space.
+        if (clipPoint.w <= 0.0f || clipPoint.z < 0.0f) {
+            return true;
+        }
+
+        float x = clipPoint.x / clipPoint.w;
+        float y = clipPoint.y / clipPoint.w;
+        float z = clipPoint.z / clipPoint.w;
+        if (first) {
+            minX = maxX = x;
+            minY = maxY = y;
+            minZ = z;
+            first = false;
+        } else {
+            minX = std::min(minX, x);
+            maxX = std::max(maxX, x);
+            minY = std::min(minY, y);
+            maxY = std::max(maxY, y);
+            minZ = std::min(minZ, z);
+        }
+    }
+
+    if (maxX < -1.0f || minX > 1.0f || maxY < -1.0f || minY > 1.0f || minZ > 1.0f) {
+        return false;
+    }
+
+    auto toPixel = [](float ndc, std::size_t extent) {
+        float pixel = std::floor((ndc + 1.0f) * 0.5f * static_cast<float>(extent));
+        float last = static_cast<float>(extent - 1);
+        return static_cast<std::size_t>(std::min(std::max(pixel, 0.0f), last));
+    };
+    std::size_t x0 = toPixel(minX, m_width);
+    std::size_t x1 = toPixel(maxX, m_width);
+    std::size_t y0 = toPixel(minY, m_height);
+    std::size_t y1 = toPixel(maxY, m_height);
+
+    // Pick the finest level where the rectangle spans at most 2 x 2 texels.
+    std::size_t level = 0;
+    while (level + 1 < m_levels.size() &&
+        ((x1 >> level) - (x0 >> level) > 1 || (y1 >> level) - (y0 >> level) > 1)
+    ) {
+        level++;
+    }
+
+    const auto& depths = m_levels[level];
+    std::size_t levelWidth = m_levelWidths[level];
+    float maxDepth = 0.0f;
+    for (std::size_t y = y0 >> level; y <= (y1 >> level); y++) {
+        for (std::size_t x = x0 >> level; x <= (x1 >> level); x++) {
+            maxDepth = std::max(maxDepth, depths[y * levelWidth + x]);
+        }
+    }
+
+    return minZ <= maxDepth;
+}
+
+std::size_t glm_vulkan::OcclusionBuffer::test_aabbs(
+    const glm::vec3* aabbMins,
+    const glm::vec3* aabbMaxs,
+    std::size_t count,
+    const glm::mat4x4& modelViewProjection,
+    bool* visible
+) const {
+    GLM_VULKAN_INSTRUMENT(InstrumentedFunction::OCCLUSION_TEST_AABBS, count);
+
+    std::size_t visibleCount = 0;
+    for (std::size_t i = 0; i < count; i++) {
+        visible[i] = this->is_visible(aabbMins[i], aabbMaxs[i], modelViewProjection);
+        visibleCount += visible[i] ? 1 : 0;
+    }
+    GLM_VULKAN_INSTRUMENT_CULLING(visibleCount, count - visibleCount);
+
+    return visibleCount;
+}
@@ -0,0 +1,209 @@
+#ifndef _GLM_VULKAN_OCCLUSION_H
+#define _GLM_VULKAN_OCCLUSION_H
+
+#include <glm/vec3.hpp>
+#include <glm/vec4.hpp>
+#include <glm/mat4x4.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+
+namespace glm_vulkan {
+    /// @brief A low resolution software depth buffer for conservative CPU occlusion
+    /// culling in Vulkan's clip space.
+    ///
+    /// @details The occlusion buffer consumes clip space coordinates produced by
+    /// the projection matrices `perspective_fov`, `perspective_frustum`, and
+    /// `orthographic_frustum`, composed with the caller's view and model
+    /// transformations. It follows the same conventions as the projections:
+    /// @li The clip space `y-axis` faces down, so row `0` of the buffer is the top
+    /// row of the viewport.
+    /// @li Depth in normalized device coordinates lies in `[0, 1]`, with `0` at the
+    /// near plane and `1` at the far plane.
+    ///
+    /// A frame of occlusion culling runs in four steps:
+    /// @li `clear` resets every pixel to the far plane depth `1`.
+    /// @li `add_occluder` transforms an occluder triangle mesh into clip space and
+    /// bins each triangle into the `TILE_SIZE x TILE_SIZE` screen tiles its bounding
+    /// box overlaps.
+    /// @li `rasterize` rasterizes the binned triangles tile by tile, and then builds
+    /// a hierarchical depth (Hi-Z) pyramid where each texel stores the farthest
+    /// depth of the texels below it. To spread the tiles across worker threads,
+    /// call `rasterize_tile_range` on disjoint tile ranges followed by
+    /// `build_hierarchy` instead.
+    /// @li `is_visible` and `test_aabbs` test occludee bounding boxes against the
+    /// Hi-Z pyramid.
+    ///
+    /// The test is conservative with respect to occludees: a bounding box that
+    /// crosses the near plane, or that cannot be resolved against the pyramid, is
+    /// reported as visible. Occluder triangles that cross the near plane are
+    /// dropped, which only reduces the amount of occlusion found. Occluders are
+    /// sampled at pixel centers, so occluders should be conservative proxies lying
+    /// inside the real geometry.
+    class OcclusionBuffer {
+    public:
+        /// @brief The width and height in pixels of a screen tile.
+        static constexpr std::size_t TILE_SIZE = 8;
+
+        /// @brief Construct an occlusion buffer covering a viewport of
+        /// `width x height` pixels.
+        ///
+        /// @details The storage is padded up to a whole number of tiles in each
+        /// dimension. The padding does not take part in occlusion tests, so any
+        /// viewport size is culled as well as a whole number of tiles. The buffer
+        /// starts out cleared.
+        ///
+        /// @pre width > 0
+        /// @pre height > 0
+        ///
+        /// @section Parameters
+        /// @param width the width of the viewport in pixels.
+        /// @param height the height of the viewport in pixels.
+        OcclusionBuffer(std::size_t width, std::size_t height);
+
+        /// @brief The width of the viewport in pixels.
+        std::size_t width() const;
+
+        /// @brief The height of the viewport in pixels.
+        std::size_t height() const;
+
+        /// @brief Reset every pixel to the far plane depth and discard all binned
+        /// occluder triangles.
+        void clear();
+
+        /// @brief Transform an indexed triangle mesh into clip space and bin its
+        /// triangles into screen tiles.
+        ///
+        /// @details Triangles are rasterized double-sided. Triangles lying entirely
+        /// outside the view volume, degenerate triangles, and triangles crossing the
+        /// near plane are discarded.
+        ///
+        /// @pre indexCount % 3 == 0
+        /// @pre every index is less than vertexCount
+        ///
+        /// @section Parameters
+        /// @param vertices the mesh vertex positions in model space.
+        /// @param vertexCount the number of vertices in `vertices`.
+        /// @param indices the triangle list indices into `vertices`.
+        /// @param indexCount the number of indices in `indices`.
+        /// @param modelViewProjection the transformation from model space to
+        /// Vulkan clip space.
+        void add_occluder(
+            const glm::vec3* vertices,
+            std::size_t vertexCount,
+            const std::uint32_t* indices,
+            std::size_t indexCount,
+            const glm::mat4x4& modelViewProjection
+        );
+
+        /// @brief Rasterize every binned occluder triangle into the depth buffer on
+        /// the calling thread and rebuild the Hi-Z pyramid.
+        ///
+        /// @details This is equivalent to `rasterize_tile_range(0, tile_count())`
+        /// followed by `build_hierarchy()`.
+        void rasterize();
+
+        /// @brief The number of screen tiles the viewport is divided into.
+        std::size_t tile_count() const;
+
+        /// @brief Rasterize the binned occluder triangles of the tiles in the range
+        /// `[begin, end)` into the depth buffer.
+        ///
+        /// @details Tiles are independent, so calls with disjoint ranges may run
+        /// concurrently on the caller's worker threads, for example as jobs in an
+        /// engine's job system. The result does not depend on how the tiles are
+        /// split. Call `build_hierarchy` once every tile has been rasterized.
+        ///
+        /// @pre begin <= end
+        /// @pre end <= tile_count()
+        ///
+        /// @section Parameters
+        /// @param begin the index of the first tile to rasterize.
+        /// @param end one past the index of the last tile to rasterize.
+        void rasterize_tile_range(std::size_t begin, std::size_t end);
+
+        /// @brief Rebuild the Hi-Z pyramid from the depth buffer after its tiles
+        /// have been rasterized with `rasterize_tile_range`.
+        void build_hierarchy();
+
+        /// @brief Read back the depth of a pixel after `rasterize`.
+        ///
+        /// @pre x < width()
+        /// @pre y < height()
+        ///
+        /// @section Parameters
+        /// @param x the column of the pixel, counted from the left.
+        /// @param y the row of the pixel, counted from the top.
+        ///
+        /// @return the nearest occluder depth in `[0, 1]` at the pixel center.
+        float depth(std::size_t x, std::size_t y) const;
+
+        /// @brief Test whether an axis-aligned bounding box may be visible.
+        ///
+        /// @section Parameters
+        /// @param aabbMin the minimum corner of the bounding box in model space.
+        /// @param aabbMax the maximum corner of the bounding box in model space.
+        /// @param modelViewProjection the transformation from model space to
+        /// Vulkan clip space.
+        ///
+        /// @return `false` if the bounding box lies outside the view volume or
+        /// behind the occluders rasterized so far, and `true` otherwise.
+        bool is_visible(
+            const glm::vec3& aabbMin,
+            const glm::vec3& aabbMax,
+            const glm::mat4x4& modelViewProjection
+        ) const;
+
+        /// @brief Test a batch of axis-aligned bounding boxes sharing a single
+        /// transformation.
+        ///
+        /// @section Parameters
+        /// @param aabbMins the minimum corners of the bounding boxes.
+        /// @param aabbMaxs the maximum corners of the bounding boxes.
+        /// @param count the number of bounding boxes.
+        /// @param modelViewProjection the transformation from the space the
+        /// bounding boxes are expressed in to Vulkan clip space.
+        /// @param visible the output array of `count` results, as given by
+        /// `is_visible`.
+        ///
+        /// @return the number of bounding boxes that may be visible.
+        std::size_t test_aabbs(
+            const glm::vec3* aabbMins,
+            const glm::vec3* aabbMaxs,
+            std::size_t count,
+            const glm::mat4x4& modelViewProjection,
+            bool* visible
+        ) const;
+
+    private:
+        struct Triangle {
+            float edgeA[3];
+            float edgeB[3];
+            float edgeC[3];
+            float depthA;
+            float depthB;
+            float depthC;
+            std::int32_t minX;
+            std::int32_t minY;
+            std::int32_t maxX;
+            std::int32_t maxY;
+        };
+
+        void add_triangle(const glm::vec4& v0, const glm::vec4& v1, const glm::vec4& v2);
+        void rasterize_tile(std::size_t tileIndex);
+
+        std::size_t m_width;
+        std::size_t m_height;
+        std::size_t m_tilesX;
+        std::size_t m_tilesY;
+        std::vector<Triangle> m_triangles;
+        std::vector<std::vector<std::uint32_t>> m_bins;
+        std::vector<std::size_t> m_levelWidths;
+        std::vector<std::size_t> m_levelHeights;
+        std::vector<std::vector<float>> m_levels;
+    };
+}
+
+#endif // _GLM_VULKAN_OCCLUSION_H
@@ -0,0 +1,309 @@
+#include "glm_vulkan_shadow_culling.h"
+
+#include <glm/geometric.hpp>
+#include <glm/matrix.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+#ifdef GLM_VULKAN_ENABLE_INSTRUMENTATION
+#include "glm_vulkan_instrumentation.h"
+#else
+#define GLM_VULKAN_INSTRUMENT(function, elements) ((void)0)
+#define GLM_VULKAN_INSTRUMENT_CULLING(accepted, culled) ((void)0)
+#endif
+
+
+namespace {
+    // Faces of a hexahedron with corners indexed as in `frustum_corners`. Face
+    // `2 * axis + side` contains the corners whose bit `axis` equals `side`.
+    constexpr std::size_t FACE_COUNT = 6;
+
+    // The number of bounding volumes culled at a time. The per-volume results of
+    // a batch stay in a byte mask on the stack while every plane is applied.
+    constexpr std::size_t CULLING_BATCH_SIZE = 256;
+
+    glm::vec4 plane_through_points(const glm::vec3& normal, const glm::vec3& point, const glm::vec3& inside) {
+        float length = glm::length(normal);
+        if (length < 1.0e-12f) {
+            return glm::vec4 { 0.0f, 0.0f, 0.0f, 0.0f };
+        }
+
+        glm::vec3 unitNormal = normal / length;
+        float distance = -glm::dot(unitNormal, point);
+        if (glm::dot(unitNormal, inside) + distance < 0.0f) {
+            unitNormal = -unitNormal;
+            distance = -distance;
+        }
+
+        return glm::vec4 { unitNormal, distance };
+    }
+
+    bool is_degenerate(const glm::vec4& plane) {
+        return plane.x == 0.0f && plane.y == 0.0f && plane.z == 0.0f;
+    }
+
+    glm::vec3 centroid(const std::array<glm::vec3, 8>& corners) {
+        glm::vec3 sum { 0.0f, 0.0f, 0.0f };
+        for (const auto& corner : corners) {
+            sum += corner;
+        }
+
+        return sum / 8.0f;
+    }
+
+    std::array<glm::vec4, FACE_COUNT> face_planes(const std::array<glm::vec3, 8>& corners, const glm::vec3& inside) {
+        std::array<glm::vec4, FACE_COUNT> planes;
+        for (std::size_t axis = 0; axis < 3; axis++) {
+            std::size_t axisB = (axis + 1) % 3;
+            std::size_t axisC = (axis + 2) % 3;
+            for (std::size_t side = 0; side < 2; side++) {
+                std::size_t base = side << axis;
+                const auto& p00 = corners[base];
+                const auto& p10 = corners[base | (std::size_t { 1 } << axisB)];
+                const auto& p01 = corners[base | (std::size_t { 1 } << axisC)];
+                const auto& p11 = corners[base | (std::size_t { 1 } << axisB) | (std::size_t { 1 } << axisC)];
+                // The cross product of the diagonals stays well defined when one
+                // edge of the face collapses.
+                glm::vec3 normal = glm::cross(p11 - p00, p01 - p10);
+                planes[2 * axis + side] = plane_through_points(normal, (p00 + p10 + p01 + p11) * 0.25f, inside);
+            }
+        }
+
+        return planes;
+    }
+
+    // Append the faces selected by `keep`, and one plane through every edge
+    // separating a kept face from a discarded one. `edge_plane` computes the
+    // normal of the plane through the edge from its two endpoints.
+    template <typename EdgePlane>
+    std::vector<glm::vec4> silhouette_planes(
+        const std::array<glm::vec3, 8>& corners,
+        const std::array<glm::vec4, FACE_COUNT>& faces,
+        const std::array<bool, FACE_COUNT>& keep,
+        const glm::vec3& inside,
+        EdgePlane edge_plane
+    ) {
+        std::vector<glm::vec4> planes;
+        for (std::size_t face = 0; face < FACE_COUNT; face++) {
+            if (keep[face] && !is_degenerate(faces[face])) {
+                planes.push_back(faces[face]);
+            }
+        }
+
+        for (std::size_t corner = 0; corner < 8; corner++) {
+            for (std::size_t axis = 0; axis < 3; axis++) {
+                if ((corner >> axis) & 1) {
+                    continue;
+                }
+
+                std::size_t other = corner | (std::size_t { 1 } << axis);
+                std::size_t axisB = (axis + 1) % 3;
+                std::size_t axisC = (axis + 2) % 3;
+                std::size_t faceB = 2 * axisB + ((corner >> axisB) & 1);
+                std::size_t faceC = 2 * axisC + ((corner >> axisC) & 1);
+                if (keep[faceB] == keep[faceC]) {
+                    continue;
+                }
+
+                const auto& a = corners[corner];
+                const auto& b = corners[other];
+                auto plane = plane_through_points(edge_plane(a, b), a, inside);
+                if (!is_degenerate(plane)) {
+                    planes.push_back(plane);
+                }
+            }
+        }
+
+        return planes;
+    }
+}
+
+std::array<glm::vec4, 6> glm_vulkan::frustum_planes(const glm::mat4x4& viewProjection) {
+    auto row0 = glm::vec4 { viewProjection[0][0], viewProjection[1][0], viewProjection[2][0], viewProjection[3][0] };
+    auto row1 = glm::vec4 { viewProjection[0][1], viewProjection[1][1], viewProjection[2][1], viewProjection[3][1] };
+    auto row2 = glm::vec4 { viewProjection[0][2], viewProjection[1][2], viewProjection[2][2], viewProjection[3][2] };
+    auto row3 = glm::vec4 { viewProjection[0][3], viewProjection[1][3], viewProjection[2][3], viewProjection[3][3] };
+
+    std::array<glm::vec4, 6> planes = {
+        row3 + row0,
+        row3 - row0,
+        row3 + row1,
+        row3 - row1,
+        row2,
+        row3 - row2
+    };
+    for (auto& plane : planes) {
+        plane /= glm::length(glm::vec3 { plane });
+    }
+
+    return planes;
+}
+
+std::array<glm::vec3, 8> glm_vulkan::frustum_corners(const glm::mat4x4& viewProjection) {
+    auto inverseViewProjection = glm::inverse(viewProjection);
+    std::array<glm::vec3, 8> corners;
+    for (std::size_t i = 0; i < 8; i++) {
+        auto ndc = glm::vec4 {
+            (i & 1) ? 1.0f : -1.0f,
+            (i & 2) ? 1.0f : -1.0f,
+            (i & 4) ? 1.0f :  0.0f,
+            1.0f
+        };
+        auto corner = inverseViewProjection * ndc;
+        corners[i] = glm::vec3 { corner } / corner.w;
+    }
+
+    return corners;
+}
+
+std::array<glm::vec3, 8> glm_vulkan::aabb_corners(const glm::vec3& aabbMin, const glm::vec3& aabbMax) {
+    std::array<glm::vec3, 8> corners;
+    for (std::size_t i = 0; i < 8; i++) {
+        corners[i] = glm::vec3 {
+            (i & 1) ? aabbMax.x : aabbMin.x,
+            (i & 2) ? aabbMax.y : aabbMin.y,
+            (i & 4) ? aabbMax.z : aabbMin.z
+        };
+    }
+
+    return corners;
+}
+
+std::vector<glm::vec4> glm_vulkan::directional_shadow_caster_planes(
+    const std::array<glm::vec3, 8>& receiverCorners,
+    const glm::vec3& lightDirection
+) {
+    auto inside = centroid(receiverCorners);
+    auto faces = face_planes(receiverCorners, inside);
+    auto towardLight = -glm::normalize(lightDirection);
+
+    // Sweeping the receiver volume toward the light stays inside a face plane
+    // exactly when its inward normal does not point away from the light.
+    std::array<bool, FACE_COUNT> keep;
+    for (std::size_t face = 0; face < FACE_COUNT; face++) {
+        keep[face] = glm::dot(glm::vec3 { faces[face] }, towardLight) >= 0.0f;
+    }
+
+    return silhouette_planes(receiverCorners, faces, keep, inside,
+        [&towardLight](const glm::vec3& a, const glm::vec3& b) {
+            return glm::cross(b - a, towardLight);
+        }
+    );
+}
+
+std::vector<glm::vec4> glm_vulkan::spot_shadow_caster_planes(
+    const std::array<glm::vec3, 8>& receiverCorners,
+    const glm::vec3& lightPosition,
+    const glm::mat4x4& lightViewProjection
+) {
+    auto inside = centroid(receiverCorners);
+    auto faces = face_planes(receiverCorners, inside);
+
+    // A face plane bounds the hull of the receiver volume and the light exactly
+    // when the light lies on its inner side.
+    std::array<bool, FACE_COUNT> keep;
+    for (std::size_t face = 0; face < FACE_COUNT; face++) {
+        keep[face] = glm::dot(glm::vec3 { faces[face] }, lightPosition) + faces[face].w >= 0.0f;
+    }
+
+    auto planes = silhouette_planes(receiverCorners, faces, keep, inside,
+        [&lightPosition](const glm::vec3& a, const glm::vec3& b) {
+            return glm::cross(b - a, lightPosition - a);
+        }
+    );
+    for (const auto& plane : frustum_planes(lightViewProjection)) {
+        planes.push_back(plane);
+    }
+
+    return planes;
+}
+
+std::size_t glm_vulkan::cull_spheres(
+    const glm::vec4* planes,
+    std::size_t planeCount,
+    const BoundingSpheresSoA& spheres,
+    bool* visible
+) {
+    GLM_VULKAN_INSTRUMENT(InstrumentedFunction::CULL_SPHERES, spheres.count);
+
+    std::size_t visibleCount = 0;
+    for (std::size_t batch = 0; batch < spheres.count; batch += CULLING_BATCH_SIZE) {
+        std::size_t batchCount = std::min(CULLING_BATCH_SIZE, spheres.count - batch);
+        const float* __restrict centerX = spheres.centerX + batch;
+        const float* __restrict centerY = spheres.centerY + batch;
+        const float* __restrict centerZ = spheres.centerZ + batch;
+        const float* __restrict radius = spheres.radius + batch;
+        std::uint8_t mask[CULLING_BATCH_SIZE];
+        std::fill_n(mask, batchCount, std::uint8_t { 1 });
+
+        // Iterate over planes in the outer loop so the inner loop streams through
+        // the arrays with a fixed plane. The plane and the array pointers are held
+        // in locals and the results in a byte mask, so GCC vectorizes the inner
+        // loop at `-O3`.
+        for (std::size_t planeIndex = 0; planeIndex < planeCount; planeIndex++) {
+            float planeX = planes[planeIndex].x;
+            float planeY = planes[planeIndex].y;
+            float planeZ = planes[planeIndex].z;
+            float planeW = planes[planeIndex].w;
+            for (std::size_t i = 0; i < batchCount; i++) {
+                float distance = planeX * centerX[i] + planeY * centerY[i] + planeZ * centerZ[i] + planeW;
+                mask[i] &= static_cast<std::uint8_t>(distance >= -radius[i]);
+            }
+        }
+
+        for (std::size_t i = 0; i < batchCount; i++) {
+            visible[batch + i] = mask[i] != 0;
+            visibleCount += mask[i];
+        }
+    }
+    GLM_VULKAN_INSTRUMENT_CULLING(visibleCount, spheres.count - visibleCount);
+
+    return visibleCount;
+}
+
+std::size_t glm_vulkan::cull_aabbs(
+    const glm::vec4* planes,
+    std::size_t planeCount,
+    const BoundingBoxesSoA& boxes,
+    bool* visible
+) {
+    GLM_VULKAN_INSTRUMENT(InstrumentedFunction::CULL_AABBS, boxes.count);
+
+    std::size_t visibleCount = 0;
+    for (std::size_t batch = 0; batch < boxes.count; batch += CULLING_BATCH_SIZE) {
+        std::size_t batchCount = std::min(CULLING_BATCH_SIZE, boxes.count - batch);
+        const float* __restrict centerX = boxes.centerX + batch;
+        const float* __restrict centerY = boxes.centerY + batch;
+        const float* __restrict centerZ = boxes.centerZ + batch;
+        const float* __restrict extentX = boxes.extentX + batch;
+        const float* __restrict extentY = boxes.extentY + batch;
+        const float* __restrict extentZ = boxes.extentZ + batch;
+        std::uint8_t mask[CULLING_BATCH_SIZE];
+        std::fill_n(mask, batchCount, std::uint8_t { 1 });
+
+        for (std::size_t planeIndex = 0; planeIndex < planeCount; planeIndex++) {
+            float planeX = planes[planeIndex].x;
+            float planeY = planes[planeIndex].y;
+            float planeZ = planes[planeIndex].z;
+            float planeW = planes[planeIndex].w;
+            float absX = std::fabs(planeX);
+            float absY = std::fabs(planeY);
+            float absZ = std::fabs(planeZ);
+            for (std::size_t i = 0; i < batchCount; i++) {
+                float distance = planeX * centerX[i] + planeY * centerY[i] + planeZ * centerZ[i] + planeW;
+                float radius = absX * extentX[i] + absY * extentY[i] + absZ * extentZ[i];
+                mask[i] &= static_cast<std::uint8_t>(distance >= -radius);
+            }
+        }
+
+        for (std::size_t i = 0; i < batchCount; i++) {
+            visible[batch + i] = mask[i] != 0;
+            visibleCount += mask[i];
+        }
+    }
+    GLM_VULKAN_INSTRUMENT_CULLING(visibleCount, boxes.count - visibleCount);
+
+    return visibleCount;
+}
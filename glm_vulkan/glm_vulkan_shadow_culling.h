@@ -0,0 +1,167 @@
+#ifndef _GLM_VULKAN_SHADOW_CULLING_H
+#define _GLM_VULKAN_SHADOW_CULLING_H
+
+#include <glm/vec3.hpp>
+#include <glm/vec4.hpp>
+#include <glm/mat4x4.hpp>
+
+#include <array>
+#include <cstddef>
+#include <vector>
+
+
+namespace glm_vulkan {
+    /// @brief A structure-of-arrays view over a batch of bounding spheres.
+    ///
+    /// @details Every array holds `count` elements. The view does not own
+    /// the arrays.
+    struct BoundingSpheresSoA {
+        const float* centerX;
+        const float* centerY;
+        const float* centerZ;
+        const float* radius;
+        std::size_t count;
+    };
+
+    /// @brief A structure-of-arrays view over a batch of axis-aligned bounding
+    /// boxes given by their centers and half extents.
+    ///
+    /// @details Every array holds `count` elements. The view does not own
+    /// the arrays.
+    struct BoundingBoxesSoA {
+        const float* centerX;
+        const float* centerY;
+        const float* centerZ;
+        const float* extentX;
+        const float* extentY;
+        const float* extentZ;
+        std::size_t count;
+    };
+
+    /// @brief Extract the six clipping planes of a Vulkan view volume.
+    ///
+    /// @details The view volume is the set of points whose clip space coordinates
+    /// satisfy `-w <= x <= w`, `-w <= y <= w`, and `0 <= z <= w`, as produced by
+    /// `perspective_fov`, `perspective_frustum`, and `orthographic_frustum`. Each
+    /// plane is stored as `(n.x, n.y, n.z, d)` with a unit length inward facing
+    /// normal `n`, so that a point `p` lies inside the plane when
+    /// `dot(n, p) + d >= 0`. The planes are ordered left, right, top, bottom,
+    /// near, far.
+    ///
+    /// @section Parameters
+    /// @param viewProjection the transformation to Vulkan clip space. The planes
+    /// are expressed in the source space of the transformation.
+    ///
+    /// @return the clipping planes of the view volume.
+    std::array<glm::vec4, 6> frustum_planes(const glm::mat4x4& viewProjection);
+
+    /// @brief Compute the eight corners of a Vulkan view volume.
+    ///
+    /// @details Corner `i` is the preimage of the normalized device coordinates
+    /// point with `x == -1` if bit `0` of `i` is clear and `x == 1` otherwise,
+    /// `y == -1` or `y == 1` by bit `1`, and `z == 0` or `z == 1` by bit `2`.
+    ///
+    /// @pre viewProjection is invertible
+    ///
+    /// @section Parameters
+    /// @param viewProjection the transformation to Vulkan clip space.
+    ///
+    /// @return the corners of the view volume in the source space of the
+    /// transformation.
+    std::array<glm::vec3, 8> frustum_corners(const glm::mat4x4& viewProjection);
+
+    /// @brief Compute the eight corners of an axis-aligned bounding box in the
+    /// same order as `frustum_corners`.
+    ///
+    /// @section Parameters
+    /// @param aabbMin the minimum corner of the bounding box.
+    /// @param aabbMax the maximum corner of the bounding box.
+    ///
+    /// @return the corners of the bounding box, with bit `0` of the corner index
+    /// selecting `x`, bit `1` selecting `y`, and bit `2` selecting `z`.
+    std::array<glm::vec3, 8> aabb_corners(const glm::vec3& aabbMin, const glm::vec3& aabbMax);
+
+    /// @brief Construct the planes bounding the shadow casters of a directional
+    /// light that can cast shadows onto a receiver volume.
+    ///
+    /// @details The receiver volume is a convex hexahedron, such as the camera
+    /// view volume from `frustum_corners` or the bounds of the visible receivers
+    /// from `aabb_corners`. The returned planes bound the convex hull of the
+    /// receiver volume extruded infinitely toward the light: the planes of the
+    /// receiver volume facing away from the light, plus one plane through each
+    /// silhouette edge of the receiver volume parallel to the light direction.
+    /// The planes use the same convention as `frustum_planes`. Append the planes of
+    /// the light's `orthographic_frustum` to bound the volume toward the light.
+    ///
+    /// @section Parameters
+    /// @param receiverCorners the corners of the receiver volume in the order
+    /// given by `frustum_corners`.
+    /// @param lightDirection the direction the light travels in.
+    ///
+    /// @return the planes of the shadow caster volume.
+    std::vector<glm::vec4> directional_shadow_caster_planes(
+        const std::array<glm::vec3, 8>& receiverCorners,
+        const glm::vec3& lightDirection
+    );
+
+    /// @brief Construct the planes bounding the shadow casters of a spot light
+    /// that can cast shadows onto a receiver volume.
+    ///
+    /// @details The returned planes bound the convex hull of the receiver volume
+    /// and the light position, intersected with the light's own view volume: the
+    /// planes of the receiver volume facing away from the light, plus one plane
+    /// through each silhouette edge of the receiver volume and the light position,
+    /// plus the planes of `lightViewProjection` as given by `frustum_planes`.
+    ///
+    /// @section Parameters
+    /// @param receiverCorners the corners of the receiver volume in the order
+    /// given by `frustum_corners`.
+    /// @param lightPosition the position of the light.
+    /// @param lightViewProjection the spot light's transformation to Vulkan clip
+    /// space, typically built with `perspective_fov`.
+    ///
+    /// @return the planes of the shadow caster volume.
+    std::vector<glm::vec4> spot_shadow_caster_planes(
+        const std::array<glm::vec3, 8>& receiverCorners,
+        const glm::vec3& lightPosition,
+        const glm::mat4x4& lightViewProjection
+    );
+
+    /// @brief Test a batch of bounding spheres against a convex plane set.
+    ///
+    /// @section Parameters
+    /// @param planes the planes of the convex volume, as given by `frustum_planes`
+    /// or the shadow caster plane functions.
+    /// @param planeCount the number of planes in `planes`.
+    /// @param spheres the bounding spheres to test.
+    /// @param visible the output array of `spheres.count` results. An element is
+    /// `true` when the sphere may intersect the volume.
+    ///
+    /// @return the number of spheres that may intersect the volume.
+    std::size_t cull_spheres(
+        const glm::vec4* planes,
+        std::size_t planeCount,
+        const BoundingSpheresSoA& spheres,
+        bool* visible
+    );
+
+    /// @brief Test a batch of axis-aligned bounding boxes against a convex plane set.
+    ///
+    /// @section Parameters
+    /// @param planes the planes of the convex volume, as given by `frustum_planes`
+    /// or the shadow caster plane functions.
+    /// @param planeCount the number of planes in `planes`.
+    /// @param boxes the bounding boxes to test.
+    /// @param visible the output array of `boxes.count` results. An element is
+    /// `true` when the box may intersect the volume.
+    ///
+    /// @return the number of boxes that may intersect the volume.
+    std::size_t cull_aabbs(
+        const glm::vec4* planes,
+        std::size_t planeCount,
+        const BoundingBoxesSoA& boxes,
+        bool* visible
+    );
+}
+
+#endif // _GLM_VULKAN_SHADOW_CULLING_H
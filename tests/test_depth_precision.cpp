@@ -0,0 +1,169 @@
+#include <gtest/gtest.h>
+#include <glm/mat4x4.hpp>
+#include <glm_vulkan/glm_vulkan.h>
+#include <glm_vulkan/glm_vulkan_depth_precision.h>
+
+#include <vector>
+
+
+TEST(DepthPrecisionTests, OrthographicUnormResolutionIsUniform) {
+    float near = 1.0f;
+    float far = 100.0f;
+    auto matrix = glm_vulkan::orthographic_frustum(-1.0f, 1.0f, 1.0f, -1.0f, near, far);
+    double expected = (far - near) / 65535.0;
+
+    EXPECT_NEAR(glm_vulkan::depth_resolution(matrix, 2.0f, glm_vulkan::DepthFormat::D16_UNORM, false), expected, 1.0e-9);
+    EXPECT_NEAR(glm_vulkan::depth_resolution(matrix, 90.0f, glm_vulkan::DepthFormat::D16_UNORM, false), expected, 1.0e-9);
+}
+
+TEST(DepthPrecisionTests, PerspectiveUnormResolutionGrowsWithSquareOfDistance) {
+    float near = 1.0f;
+    float far = 100.0f;
+    auto matrix = glm_vulkan::perspective_fov(glm::pi<float>() / 2.0f, 4.0f / 3.0f, near, far);
+    float z = 10.0f;
+    double expected = (1.0 / 65535.0) * (far - near) * z * z / (far * near);
+    double result = glm_vulkan::depth_resolution(matrix, z, glm_vulkan::DepthFormat::D16_UNORM, false);
+
+    EXPECT_NEAR(result / expected, 1.0, 1.0e-5);
+}
+
+TEST(DepthPrecisionTests, PerspectiveFrustumMatchesPerspectiveFov) {
+    float near = 0.5f;
+    float far = 250.0f;
+    auto fov = glm_vulkan::perspective_fov(glm::pi<float>() / 3.0f, 16.0f / 9.0f, near, far);
+    auto frustum = glm_vulkan::perspective_frustum(-0.3f, 0.5f, 0.2f, -0.4f, near, far);
+
+    for (float z : { 1.0f, 10.0f, 200.0f }) {
+        EXPECT_DOUBLE_EQ(
+            glm_vulkan::depth_resolution(fov, z, glm_vulkan::DepthFormat::D32_SFLOAT, true),
+            glm_vulkan::depth_resolution(frustum, z, glm_vulkan::DepthFormat::D32_SFLOAT, true)
+        );
+    }
+}
+
+TEST(DepthPrecisionTests, ReversedZDoesNotChangeUnormResolution) {
+    auto matrix = glm_vulkan::perspective_fov(glm::pi<float>() / 2.0f, 1.0f, 0.1f, 1000.0f);
+
+    EXPECT_DOUBLE_EQ(
+        glm_vulkan::depth_resolution(matrix, 50.0f, glm_vulkan::DepthFormat::D16_UNORM, false),
+        glm_vulkan::depth_resolution(matrix, 50.0f, glm_vulkan::DepthFormat::D16_UNORM, true)
+    );
+}
+
+TEST(DepthPrecisionTests, ReversedZImprovesFloatResolutionAtDistance) {
+    auto matrix = glm_vulkan::perspective_fov(glm::pi<float>() / 2.0f, 1.0f, 0.1f, 1000.0f);
+    double conventional = glm_vulkan::depth_resolution(matrix, 500.0f, glm_vulkan::DepthFormat::D32_SFLOAT, false);
+    double reversed = glm_vulkan::depth_resolution(matrix, 500.0f, glm_vulkan::DepthFormat::D32_SFLOAT, true);
+
+    EXPECT_LT(reversed * 100.0, conventional);
+}
+
+TEST(DepthPrecisionTests, DepthFormatNamesAreVulkanFormats) {
+    EXPECT_STREQ(glm_vulkan::depth_format_name(glm_vulkan::DepthFormat::D16_UNORM), "D16_UNORM");
+    EXPECT_STREQ(glm_vulkan::depth_format_name(glm_vulkan::DepthFormat::D24_UNORM), "X8_D24_UNORM_PACK32");
+    EXPECT_STREQ(glm_vulkan::depth_format_name(glm_vulkan::DepthFormat::D32_SFLOAT), "D32_SFLOAT");
+}
+
+TEST(DepthPrecisionTests, FloatResolutionAtNearPlaneIsBoundedByArithmetic) {
+    float near = 0.1f;
+    float far = 1000.0f;
+    auto matrix = glm_vulkan::perspective_fov(glm::pi<float>() / 2.0f, 1.0f, near, far);
+    double result = glm_vulkan::depth_resolution(matrix, near, glm_vulkan::DepthFormat::D32_SFLOAT, false);
+
+    EXPECT_GT(result, 1.0e-10);
+    EXPECT_LT(result, 1.0e-7);
+}
+
+TEST(DepthPrecisionTests, ReversedFloatResolutionAtFarPlaneIsBoundedByArithmetic) {
+    float near = 0.1f;
+    float far = 1000.0f;
+    auto matrix = glm_vulkan::perspective_fov(glm::pi<float>() / 2.0f, 1.0f, near, far);
+    double atFar = glm_vulkan::depth_resolution(matrix, far, glm_vulkan::DepthFormat::D32_SFLOAT, true);
+    double nearFar = glm_vulkan::depth_resolution(matrix, 0.99f * far, glm_vulkan::DepthFormat::D32_SFLOAT, true);
+
+    EXPECT_GT(atFar, 1.0e-6);
+    EXPECT_LT(atFar, 1.0e-3);
+    EXPECT_LT(atFar / nearFar, 4.0);
+}
+
+TEST(DepthPrecisionTests, FloatResolutionAtFarPlaneIsNoWorseThanD24) {
+    float near = 0.1f;
+    float far = 1000.0f;
+    auto matrix = glm_vulkan::perspective_fov(glm::pi<float>() / 2.0f, 1.0f, near, far);
+
+    EXPECT_LE(
+        glm_vulkan::depth_resolution(matrix, far, glm_vulkan::DepthFormat::D32_SFLOAT, false),
+        glm_vulkan::depth_resolution(matrix, far, glm_vulkan::DepthFormat::D24_UNORM, false)
+    );
+}
+
+TEST(DepthPrecisionTests, RejectsTargetsFinerThanArithmeticAtEndpoints) {
+    auto atFar = std::vector<glm_vulkan::DepthPrecisionTarget> {
+        { 1000.0f, 1.0e-20f }
+    };
+    auto atNear = std::vector<glm_vulkan::DepthPrecisionTarget> {
+        { 0.1f, 1.0e-12f }
+    };
+
+    EXPECT_FALSE(glm_vulkan::recommend_depth_format(glm_vulkan::ProjectionKind::PERSPECTIVE, 0.1f, 1000.0f, 0.1f, atFar).satisfied);
+    EXPECT_FALSE(glm_vulkan::recommend_depth_format(glm_vulkan::ProjectionKind::PERSPECTIVE, 0.1f, 1000.0f, 0.1f, atNear).satisfied);
+}
+
+TEST(DepthPrecisionTests, RecommendsD16ForLooseOrthographicTarget) {
+    auto targets = std::vector<glm_vulkan::DepthPrecisionTarget> {
+        { 1.0f, 0.01f },
+        { 50.0f, 0.01f },
+        { 100.0f, 0.01f }
+    };
+    auto result = glm_vulkan::recommend_depth_format(glm_vulkan::ProjectionKind::ORTHOGRAPHIC, 1.0f, 100.0f, 1.0f, targets);
+
+    EXPECT_TRUE(result.satisfied);
+    EXPECT_EQ(result.format, glm_vulkan::DepthFormat::D16_UNORM);
+    EXPECT_FALSE(result.reversedZ);
+    EXPECT_EQ(result.near, 1.0f);
+}
+
+TEST(DepthPrecisionTests, RecommendsMoreBitsForFixedNearPlane) {
+    auto targets = std::vector<glm_vulkan::DepthPrecisionTarget> {
+        { 2.0f, 0.02f },
+        { 100.0f, 1.0f },
+        { 1000.0f, 10.0f }
+    };
+    auto result = glm_vulkan::recommend_depth_format(glm_vulkan::ProjectionKind::PERSPECTIVE, 0.1f, 1000.0f, 0.1f, targets);
+
+    EXPECT_TRUE(result.satisfied);
+    EXPECT_EQ(result.format, glm_vulkan::DepthFormat::D24_UNORM);
+    EXPECT_EQ(result.near, 0.1f);
+}
+
+TEST(DepthPrecisionTests, RecommendsD16WithSuggestedNearPlane) {
+    auto targets = std::vector<glm_vulkan::DepthPrecisionTarget> {
+        { 2.0f, 0.02f },
+        { 100.0f, 1.0f },
+        { 1000.0f, 10.0f }
+    };
+    auto result = glm_vulkan::recommend_depth_format(glm_vulkan::ProjectionKind::PERSPECTIVE, 0.1f, 1000.0f, 2.0f, targets);
+    auto matrix = glm_vulkan::perspective_fov(glm::pi<float>() / 2.0f, 1.0f, result.near, 1000.0f);
+
+    EXPECT_TRUE(result.satisfied);
+    EXPECT_EQ(result.format, glm_vulkan::DepthFormat::D16_UNORM);
+    EXPECT_GT(result.near, 0.1f);
+    EXPECT_LE(result.near, 2.0f);
+    for (const auto& target : targets) {
+        EXPECT_LE(
+            glm_vulkan::depth_resolution(matrix, target.eyeDepth, result.format, result.reversedZ),
+            target.maxResolution
+        );
+    }
+}
+
+TEST(DepthPrecisionTests, ReportsUnsatisfiableTargets) {
+    auto targets = std::vector<glm_vulkan::DepthPrecisionTarget> {
+        { 500.0f, 1.0e-9f }
+    };
+    auto result = glm_vulkan::recommend_depth_format(glm_vulkan::ProjectionKind::PERSPECTIVE, 0.1f, 1000.0f, 0.1f, targets);
+
+    EXPECT_FALSE(result.satisfied);
+    EXPECT_EQ(result.format, glm_vulkan::DepthFormat::D32_SFLOAT);
+    EXPECT_TRUE(result.reversedZ);
+}
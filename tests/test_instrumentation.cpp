@@ -0,0 +1,156 @@
+#include <gtest/gtest.h>
+#include <glm/vec3.hpp>
+#include <glm_vulkan/glm_vulkan.h>
+#include <glm_vulkan/glm_vulkan_instrumentation.h>
+#include <glm_vulkan/glm_vulkan_shadow_culling.h>
+
+#include <chrono>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+
+TEST(InstrumentationTests, SnapshotIsEmptyWhenCompiledOut) {
+    if (glm_vulkan::instrumentation_enabled()) {
+        GTEST_SKIP() << "built with GLM_VULKAN_ENABLE_INSTRUMENTATION";
+    }
+
+    glm_vulkan::set_instrumentation_tracing(true);
+    glm_vulkan::perspective_fov(glm::pi<float>() / 2.0f, 1.0f, 1.0f, 100.0f);
+    auto snapshot = glm_vulkan::instrumentation_snapshot();
+    auto trace = std::ostringstream {};
+    glm_vulkan::write_chrome_trace(trace);
+    glm_vulkan::set_instrumentation_tracing(false);
+
+    EXPECT_EQ(snapshot[glm_vulkan::InstrumentedFunction::PERSPECTIVE_FOV].calls, 0);
+    EXPECT_EQ(trace.str(), "{\"traceEvents\":[]}");
+}
+
+TEST(InstrumentationTests, CountsProjectionBuilderCalls) {
+    if (!glm_vulkan::instrumentation_enabled()) {
+        GTEST_SKIP() << "built without GLM_VULKAN_ENABLE_INSTRUMENTATION";
+    }
+
+    glm_vulkan::reset_instrumentation();
+    glm_vulkan::perspective_fov(glm::pi<float>() / 2.0f, 1.0f, 1.0f, 100.0f);
+    glm_vulkan::perspective_fov(glm::pi<float>() / 2.0f, 1.0f, 1.0f, 100.0f);
+    glm_vulkan::perspective_frustum(-1.0f, 1.0f, 1.0f, -1.0f, 1.0f, 100.0f);
+    glm_vulkan::orthographic_frustum(-1.0f, 1.0f, 1.0f, -1.0f, 1.0f, 100.0f);
+    auto snapshot = glm_vulkan::instrumentation_snapshot();
+
+    EXPECT_EQ(snapshot[glm_vulkan::InstrumentedFunction::PERSPECTIVE_FOV].calls, 2);
+    EXPECT_EQ(snapshot[glm_vulkan::InstrumentedFunction::PERSPECTIVE_FOV].elements, 2);
+    EXPECT_EQ(snapshot[glm_vulkan::InstrumentedFunction::PERSPECTIVE_FRUSTUM].calls, 1);
+    EXPECT_EQ(snapshot[glm_vulkan::InstrumentedFunction::ORTHOGRAPHIC_FRUSTUM].calls, 1);
+    EXPECT_EQ(snapshot[glm_vulkan::InstrumentedFunction::CULL_SPHERES].calls, 0);
+}
+
+TEST(InstrumentationTests, CountsCulledAndAcceptedElements) {
+    if (!glm_vulkan::instrumentation_enabled()) {
+        GTEST_SKIP() << "built without GLM_VULKAN_ENABLE_INSTRUMENTATION";
+    }
+
+    auto matrix = glm_vulkan::perspective_fov(glm::pi<float>() / 2.0f, 1.0f, 1.0f, 10.0f);
+    auto planes = glm_vulkan::frustum_planes(matrix);
+    float centerX[3] = { 0.0f, 0.0f, 100.0f };
+    float centerY[3] = { 0.0f, 0.0f, 0.0f };
+    float centerZ[3] = { 5.0f, 2.0f, 5.0f };
+    float radius[3] = { 1.0f, 1.0f, 1.0f };
+    bool visible[3];
+
+    glm_vulkan::reset_instrumentation();
+    glm_vulkan::cull_spheres(planes.data(), planes.size(), glm_vulkan::BoundingSpheresSoA { centerX, centerY, centerZ, radius, 3 }, visible);
+    auto counters = glm_vulkan::instrumentation_snapshot()[glm_vulkan::InstrumentedFunction::CULL_SPHERES];
+
+    EXPECT_EQ(counters.calls, 1);
+    EXPECT_EQ(counters.elements, 3);
+    EXPECT_EQ(counters.accepted, 2);
+    EXPECT_EQ(counters.culled, 1);
+}
+
+TEST(InstrumentationTests, SnapshotSumsAcrossThreads) {
+    if (!glm_vulkan::instrumentation_enabled()) {
+        GTEST_SKIP() << "built without GLM_VULKAN_ENABLE_INSTRUMENTATION";
+    }
+
+    glm_vulkan::reset_instrumentation();
+    auto threads = std::vector<std::thread> {};
+    for (std::size_t i = 0; i < 4; i++) {
+        threads.emplace_back([]() {
+            for (std::size_t j = 0; j < 100; j++) {
+                glm_vulkan::perspective_fov(glm::pi<float>() / 2.0f, 1.0f, 1.0f, 100.0f);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    auto snapshot = glm_vulkan::instrumentation_snapshot();
+
+    EXPECT_EQ(snapshot[glm_vulkan::InstrumentedFunction::PERSPECTIVE_FOV].calls, 400);
+}
+
+TEST(InstrumentationTests, SnapshotWithResetStartsNewInterval) {
+    if (!glm_vulkan::instrumentation_enabled()) {
+        GTEST_SKIP() << "built without GLM_VULKAN_ENABLE_INSTRUMENTATION";
+    }
+
+    glm_vulkan::reset_instrumentation();
+    glm_vulkan::orthographic_frustum(-1.0f, 1.0f, 1.0f, -1.0f, 1.0f, 100.0f);
+    auto first = glm_vulkan::instrumentation_snapshot(true);
+    auto second = glm_vulkan::instrumentation_snapshot();
+
+    EXPECT_EQ(first[glm_vulkan::InstrumentedFunction::ORTHOGRAPHIC_FRUSTUM].calls, 1);
+    EXPECT_EQ(second[glm_vulkan::InstrumentedFunction::ORTHOGRAPHIC_FRUSTUM].calls, 0);
+}
+
+TEST(InstrumentationTests, WritesChromeTraceEvents) {
+    if (!glm_vulkan::instrumentation_enabled()) {
+        GTEST_SKIP() << "built without GLM_VULKAN_ENABLE_INSTRUMENTATION";
+    }
+
+    glm_vulkan::set_instrumentation_tracing(true);
+    glm_vulkan::perspective_frustum(-1.0f, 1.0f, 1.0f, -1.0f, 1.0f, 100.0f);
+    glm_vulkan::set_instrumentation_tracing(false);
+    glm_vulkan::orthographic_frustum(-1.0f, 1.0f, 1.0f, -1.0f, 1.0f, 100.0f);
+    auto trace = std::ostringstream {};
+    glm_vulkan::write_chrome_trace(trace);
+    auto emptyTrace = std::ostringstream {};
+    glm_vulkan::write_chrome_trace(emptyTrace);
+
+    EXPECT_EQ(trace.str().rfind("{\"traceEvents\":[{\"name\":\"perspective_frustum\"", 0), 0);
+    EXPECT_NE(trace.str().find("\"ph\":\"X\""), std::string::npos);
+    EXPECT_EQ(trace.str().find("orthographic_frustum"), std::string::npos);
+    EXPECT_EQ(emptyTrace.str(), "{\"traceEvents\":[]}");
+}
+
+TEST(InstrumentationTests, TraceTimestampsKeepSubmicrosecondPrecision) {
+    if (!glm_vulkan::instrumentation_enabled()) {
+        GTEST_SKIP() << "built without GLM_VULKAN_ENABLE_INSTRUMENTATION";
+    }
+
+    // Run past the first second of the trace epoch, where six significant
+    // digits can no longer resolve single microseconds.
+    glm_vulkan::reset_instrumentation();
+    std::this_thread::sleep_for(std::chrono::milliseconds { 1100 });
+    glm_vulkan::set_instrumentation_tracing(true);
+    glm_vulkan::perspective_fov(glm::pi<float>() / 2.0f, 1.0f, 1.0f, 100.0f);
+    glm_vulkan::set_instrumentation_tracing(false);
+    auto out = std::ostringstream {};
+    glm_vulkan::write_chrome_trace(out);
+    auto trace = out.str();
+
+    for (const auto* key : { "\"ts\":", "\"dur\":" }) {
+        auto start = trace.find(key);
+        ASSERT_NE(start, std::string::npos);
+        start += std::string { key }.size();
+        auto value = trace.substr(start, trace.find(',', start) - start);
+        auto point = value.find('.');
+
+        EXPECT_EQ(value.find_first_not_of("0123456789."), std::string::npos) << value;
+        ASSERT_NE(point, std::string::npos) << value;
+        EXPECT_EQ(value.size() - point - 1, 3) << value;
+    }
+    EXPECT_GE(std::stod(trace.substr(trace.find("\"ts\":") + 5)), 1.1e6);
+}
@@ -0,0 +1,206 @@
+#include <gtest/gtest.h>
+#include <glm/mat4x4.hpp>
+#include <glm/vec3.hpp>
+#include <glm_vulkan/glm_vulkan.h>
+#include <glm_vulkan/glm_vulkan_occlusion.h>
+
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+
+static glm_vulkan::OcclusionBuffer occlusionBufferWithQuad(const glm::mat4x4& matrix) {
+    auto vertices = std::vector<glm::vec3> {
+        glm::vec3 { -5.0f, -5.0f, 10.0f },
+        glm::vec3 {  5.0f, -5.0f, 10.0f },
+        glm::vec3 {  5.0f,  5.0f, 10.0f },
+        glm::vec3 { -5.0f,  5.0f, 10.0f }
+    };
+    auto indices = std::vector<std::uint32_t> { 0, 1, 2, 0, 2, 3 };
+    auto buffer = glm_vulkan::OcclusionBuffer { 64, 48 };
+    buffer.add_occluder(vertices.data(), vertices.size(), indices.data(), indices.size(), matrix);
+    buffer.rasterize();
+
+    return buffer;
+}
+
+TEST(OcclusionBufferTests, ClearedBufferIsAtFarPlane) {
+    auto buffer = glm_vulkan::OcclusionBuffer { 64, 48 };
+    buffer.rasterize();
+
+    EXPECT_EQ(buffer.depth(0, 0), 1.0f);
+    EXPECT_EQ(buffer.depth(63, 47), 1.0f);
+}
+
+TEST(OcclusionBufferTests, OccluderDepthMatchesNormalizedDeviceDepth) {
+    float near = 1.0f;
+    float far = 100.0f;
+    auto matrix = glm_vulkan::perspective_fov(glm::pi<float>() / 2.0f, 4.0f / 3.0f, near, far);
+    auto buffer = occlusionBufferWithQuad(matrix);
+    float expected = (far / (far - near)) * (1.0f - near / 10.0f);
+    float result = buffer.depth(32, 24);
+
+    EXPECT_FLOAT_EQ(result, expected);
+    EXPECT_EQ(buffer.depth(0, 0), 1.0f);
+}
+
+TEST(OcclusionBufferTests, OccluderFollowsVulkanYDownConvention) {
+    auto matrix = glm_vulkan::perspective_fov(glm::pi<float>() / 2.0f, 4.0f / 3.0f, 1.0f, 100.0f);
+    auto vertices = std::vector<glm::vec3> {
+        glm::vec3 { -20.0f, 0.0f, 10.0f },
+        glm::vec3 {  20.0f, 0.0f, 10.0f },
+        glm::vec3 {  20.0f, 20.0f, 10.0f },
+        glm::vec3 { -20.0f, 20.0f, 10.0f }
+    };
+    auto indices = std::vector<std::uint32_t> { 0, 1, 2, 0, 2, 3 };
+    auto buffer = glm_vulkan::OcclusionBuffer { 64, 48 };
+    buffer.add_occluder(vertices.data(), vertices.size(), indices.data(), indices.size(), matrix);
+    buffer.rasterize();
+
+    EXPECT_EQ(buffer.depth(32, 4), 1.0f);
+    EXPECT_LT(buffer.depth(32, 44), 1.0f);
+}
+
+TEST(OcclusionBufferTests, BoxBehindOccluderIsNotVisible) {
+    auto matrix = glm_vulkan::perspective_fov(glm::pi<float>() / 2.0f, 4.0f / 3.0f, 1.0f, 100.0f);
+    auto buffer = occlusionBufferWithQuad(matrix);
+    auto aabbMin = glm::vec3 { -1.0f, -1.0f, 20.0f };
+    auto aabbMax = glm::vec3 {  1.0f,  1.0f, 22.0f };
+
+    EXPECT_FALSE(buffer.is_visible(aabbMin, aabbMax, matrix));
+}
+
+TEST(OcclusionBufferTests, ViewportPaddingDoesNotHideOcclusion) {
+    auto matrix = glm_vulkan::perspective_fov(glm::pi<float>() / 2.0f, 61.0f / 45.0f, 1.0f, 100.0f);
+    auto vertices = std::vector<glm::vec3> {
+        glm::vec3 { -100.0f, -100.0f, 10.0f },
+        glm::vec3 {  100.0f, -100.0f, 10.0f },
+        glm::vec3 {  100.0f,  100.0f, 10.0f },
+        glm::vec3 { -100.0f,  100.0f, 10.0f }
+    };
+    auto indices = std::vector<std::uint32_t> { 0, 1, 2, 0, 2, 3 };
+    auto buffer = glm_vulkan::OcclusionBuffer { 61, 45 };
+    buffer.add_occluder(vertices.data(), vertices.size(), indices.data(), indices.size(), matrix);
+    buffer.rasterize();
+    auto aabbMin = glm::vec3 { -40.0f, -30.0f, 50.0f };
+    auto aabbMax = glm::vec3 {  40.0f,  30.0f, 60.0f };
+
+    EXPECT_FALSE(buffer.is_visible(aabbMin, aabbMax, matrix));
+    EXPECT_LT(buffer.depth(60, 44), 1.0f);
+}
+
+TEST(OcclusionBufferTests, BoxInFrontOfOccluderIsVisible) {
+    auto matrix = glm_vulkan::perspective_fov(glm::pi<float>() / 2.0f, 4.0f / 3.0f, 1.0f, 100.0f);
+    auto buffer = occlusionBufferWithQuad(matrix);
+    auto aabbMin = glm::vec3 { -1.0f, -1.0f, 2.0f };
+    auto aabbMax = glm::vec3 {  1.0f,  1.0f, 3.0f };
+
+    EXPECT_TRUE(buffer.is_visible(aabbMin, aabbMax, matrix));
+}
+
+TEST(OcclusionBufferTests, BoxBesideOccluderIsVisible) {
+    auto matrix = glm_vulkan::perspective_fov(glm::pi<float>() / 2.0f, 4.0f / 3.0f, 1.0f, 100.0f);
+    auto buffer = occlusionBufferWithQuad(matrix);
+    auto aabbMin = glm::vec3 { 15.0f, -1.0f, 20.0f };
+    auto aabbMax = glm::vec3 { 17.0f,  1.0f, 22.0f };
+
+    EXPECT_TRUE(buffer.is_visible(aabbMin, aabbMax, matrix));
+}
+
+TEST(OcclusionBufferTests, BoxPartiallyBehindOccluderIsVisible) {
+    auto matrix = glm_vulkan::perspective_fov(glm::pi<float>() / 2.0f, 4.0f / 3.0f, 1.0f, 100.0f);
+    auto buffer = occlusionBufferWithQuad(matrix);
+    auto aabbMin = glm::vec3 { 0.0f, -1.0f, 20.0f };
+    auto aabbMax = glm::vec3 { 15.0f, 1.0f, 22.0f };
+
+    EXPECT_TRUE(buffer.is_visible(aabbMin, aabbMax, matrix));
+}
+
+TEST(OcclusionBufferTests, BoxCrossingNearPlaneIsVisible) {
+    auto matrix = glm_vulkan::perspective_fov(glm::pi<float>() / 2.0f, 4.0f / 3.0f, 1.0f, 100.0f);
+    auto buffer = occlusionBufferWithQuad(matrix);
+    auto aabbMin = glm::vec3 { -1.0f, -1.0f, -1.0f };
+    auto aabbMax = glm::vec3 {  1.0f,  1.0f, 20.0f };
+
+    EXPECT_TRUE(buffer.is_visible(aabbMin, aabbMax, matrix));
+}
+
+TEST(OcclusionBufferTests, BoxOutsideFrustumIsNotVisible) {
+    auto matrix = glm_vulkan::perspective_fov(glm::pi<float>() / 2.0f, 4.0f / 3.0f, 1.0f, 100.0f);
+    auto buffer = occlusionBufferWithQuad(matrix);
+    auto aabbMin = glm::vec3 { -100.0f, -1.0f, 20.0f };
+    auto aabbMax = glm::vec3 { -90.0f,   1.0f, 22.0f };
+
+    EXPECT_FALSE(buffer.is_visible(aabbMin, aabbMax, matrix));
+}
+
+TEST(OcclusionBufferTests, OrthographicOccluderHidesBoxBehindIt) {
+    auto matrix = glm_vulkan::orthographic_frustum(-10.0f, 10.0f, 10.0f, -10.0f, 1.0f, 100.0f);
+    auto buffer = occlusionBufferWithQuad(matrix);
+    auto hiddenMin = glm::vec3 { -2.0f, -2.0f, 50.0f };
+    auto hiddenMax = glm::vec3 {  2.0f,  2.0f, 60.0f };
+    auto visibleMin = glm::vec3 { 6.0f, -4.0f, 50.0f };
+    auto visibleMax = glm::vec3 { 8.0f,  4.0f, 60.0f };
+
+    EXPECT_FALSE(buffer.is_visible(hiddenMin, hiddenMax, matrix));
+    EXPECT_TRUE(buffer.is_visible(visibleMin, visibleMax, matrix));
+}
+
+TEST(OcclusionBufferTests, BatchTestMatchesSingleTests) {
+    auto matrix = glm_vulkan::perspective_fov(glm::pi<float>() / 2.0f, 4.0f / 3.0f, 1.0f, 100.0f);
+    auto buffer = occlusionBufferWithQuad(matrix);
+    auto aabbMins = std::vector<glm::vec3> {
+        glm::vec3 { -1.0f, -1.0f, 20.0f },
+        glm::vec3 { -1.0f, -1.0f, 2.0f },
+        glm::vec3 { 15.0f, -1.0f, 20.0f }
+    };
+    auto aabbMaxs = std::vector<glm::vec3> {
+        glm::vec3 {  1.0f, 1.0f, 22.0f },
+        glm::vec3 {  1.0f, 1.0f, 3.0f },
+        glm::vec3 { 17.0f, 1.0f, 22.0f }
+    };
+    bool visible[3] = { false, false, false };
+    std::size_t result = buffer.test_aabbs(aabbMins.data(), aabbMaxs.data(), 3, matrix, visible);
+
+    EXPECT_EQ(result, 2);
+    for (std::size_t i = 0; i < 3; i++) {
+        EXPECT_EQ(visible[i], buffer.is_visible(aabbMins[i], aabbMaxs[i], matrix));
+    }
+}
+
+TEST(OcclusionBufferTests, TileRangesOnWorkerThreadsMatchRasterize) {
+    auto matrix = glm_vulkan::perspective_fov(glm::pi<float>() / 2.0f, 4.0f / 3.0f, 1.0f, 100.0f);
+    auto expected = occlusionBufferWithQuad(matrix);
+    auto vertices = std::vector<glm::vec3> {
+        glm::vec3 { -5.0f, -5.0f, 10.0f },
+        glm::vec3 {  5.0f, -5.0f, 10.0f },
+        glm::vec3 {  5.0f,  5.0f, 10.0f },
+        glm::vec3 { -5.0f,  5.0f, 10.0f }
+    };
+    auto indices = std::vector<std::uint32_t> { 0, 1, 2, 0, 2, 3 };
+    auto result = glm_vulkan::OcclusionBuffer { 64, 48 };
+    result.add_occluder(vertices.data(), vertices.size(), indices.data(), indices.size(), matrix);
+    std::size_t tileCount = result.tile_count();
+    std::size_t threadCount = 4;
+    auto workers = std::vector<std::thread> {};
+    for (std::size_t i = 0; i < threadCount; i++) {
+        workers.emplace_back([&result, i, tileCount, threadCount]() {
+            result.rasterize_tile_range(i * tileCount / threadCount, (i + 1) * tileCount / threadCount);
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    result.build_hierarchy();
+
+    EXPECT_EQ(tileCount, 48);
+    for (std::size_t y = 0; y < expected.height(); y++) {
+        for (std::size_t x = 0; x < expected.width(); x++) {
+            EXPECT_EQ(result.depth(x, y), expected.depth(x, y));
+        }
+    }
+    EXPECT_EQ(
+        result.is_visible(glm::vec3 { -1.0f, -1.0f, 20.0f }, glm::vec3 { 1.0f, 1.0f, 22.0f }, matrix),
+        expected.is_visible(glm::vec3 { -1.0f, -1.0f, 20.0f }, glm::vec3 { 1.0f, 1.0f, 22.0f }, matrix)
+    );
+}
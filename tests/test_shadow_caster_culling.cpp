@@ -0,0 +1,226 @@
+#include <gtest/gtest.h>
+#include <glm/mat4x4.hpp>
+#include <glm/vec3.hpp>
+#include <glm/vec4.hpp>
+#include <glm_vulkan/glm_vulkan.h>
+#include <glm_vulkan/glm_vulkan_shadow_culling.h>
+
+#include <memory>
+#include <vector>
+
+
+struct Spheres {
+    std::vector<float> centerX;
+    std::vector<float> centerY;
+    std::vector<float> centerZ;
+    std::vector<float> radius;
+
+    void push(const glm::vec3& center, float r) {
+        centerX.push_back(center.x);
+        centerY.push_back(center.y);
+        centerZ.push_back(center.z);
+        radius.push_back(r);
+    }
+
+    glm_vulkan::BoundingSpheresSoA view() const {
+        return glm_vulkan::BoundingSpheresSoA {
+            centerX.data(), centerY.data(), centerZ.data(), radius.data(), radius.size()
+        };
+    }
+};
+
+struct Boxes {
+    std::vector<float> centerX;
+    std::vector<float> centerY;
+    std::vector<float> centerZ;
+    std::vector<float> extentX;
+    std::vector<float> extentY;
+    std::vector<float> extentZ;
+
+    void push(const glm::vec3& center, const glm::vec3& extent) {
+        centerX.push_back(center.x);
+        centerY.push_back(center.y);
+        centerZ.push_back(center.z);
+        extentX.push_back(extent.x);
+        extentY.push_back(extent.y);
+        extentZ.push_back(extent.z);
+    }
+
+    glm_vulkan::BoundingBoxesSoA view() const {
+        return glm_vulkan::BoundingBoxesSoA {
+            centerX.data(), centerY.data(), centerZ.data(),
+            extentX.data(), extentY.data(), extentZ.data(),
+            extentX.size()
+        };
+    }
+};
+
+static glm::mat4x4 cameraViewProjection() {
+    return glm_vulkan::perspective_fov(glm::pi<float>() / 2.0f, 1.0f, 1.0f, 10.0f);
+}
+
+// A view transformation for a light at `position` looking along the world
+// `positive y-axis`, with eye space `x` along world `x` and eye space `y` along
+// world `negative z`.
+static glm::mat4x4 lightLookingDown(const glm::vec3& position) {
+    auto view = glm::mat4x4 {
+        1.0f,  0.0f, 0.0f, 0.0f,
+        0.0f,  0.0f, 1.0f, 0.0f,
+        0.0f, -1.0f, 0.0f, 0.0f,
+        0.0f,  0.0f, 0.0f, 1.0f
+    };
+    view[3] = view * glm::vec4 { -position, 1.0f };
+
+    return view;
+}
+
+TEST(ShadowCasterCullingTests, FrustumPlanesContainFrustumCorners) {
+    auto matrix = cameraViewProjection();
+    auto planes = glm_vulkan::frustum_planes(matrix);
+    auto corners = glm_vulkan::frustum_corners(matrix);
+
+    for (const auto& plane : planes) {
+        for (const auto& corner : corners) {
+            EXPECT_GE(glm::dot(glm::vec3 { plane }, corner) + plane.w, -1.0e-4f);
+        }
+    }
+}
+
+TEST(ShadowCasterCullingTests, FrustumCornersFollowVulkanConventions) {
+    auto corners = glm_vulkan::frustum_corners(cameraViewProjection());
+
+    EXPECT_NEAR(corners[0].x, -1.0f, 1.0e-4f);
+    EXPECT_NEAR(corners[0].y, -1.0f, 1.0e-4f);
+    EXPECT_NEAR(corners[0].z,  1.0f, 1.0e-4f);
+    EXPECT_NEAR(corners[7].x,  10.0f, 1.0e-3f);
+    EXPECT_NEAR(corners[7].y,  10.0f, 1.0e-3f);
+    EXPECT_NEAR(corners[7].z,  10.0f, 1.0e-3f);
+}
+
+TEST(ShadowCasterCullingTests, FrustumPlanesCullSpheresOutsideCameraFrustum) {
+    auto planes = glm_vulkan::frustum_planes(cameraViewProjection());
+    auto spheres = Spheres {};
+    spheres.push(glm::vec3 { 0.0f, 0.0f, 5.0f }, 0.5f);
+    spheres.push(glm::vec3 { 0.0f, 0.0f, 20.0f }, 0.5f);
+    bool visible[2] = { false, true };
+
+    EXPECT_EQ(glm_vulkan::cull_spheres(planes.data(), planes.size(), spheres.view(), visible), 1);
+    EXPECT_TRUE(visible[0]);
+    EXPECT_FALSE(visible[1]);
+}
+
+TEST(ShadowCasterCullingTests, CullsBatchesLargerThanOneKernelPass) {
+    auto planes = glm_vulkan::frustum_planes(cameraViewProjection());
+    auto boxes = Boxes {};
+    for (std::size_t i = 0; i < 600; i++) {
+        float z = (i % 3 == 0) ? 20.0f : 5.0f;
+        boxes.push(glm::vec3 { 0.0f, 0.0f, z }, glm::vec3 { 0.5f, 0.5f, 0.5f });
+    }
+    auto visible = std::make_unique<bool[]>(600);
+
+    EXPECT_EQ(glm_vulkan::cull_aabbs(planes.data(), planes.size(), boxes.view(), visible.get()), 400);
+    for (std::size_t i = 0; i < 600; i++) {
+        EXPECT_EQ(visible[i], i % 3 != 0);
+    }
+}
+
+TEST(ShadowCasterCullingTests, DirectionalLightKeepsCastersInsideCameraFrustum) {
+    auto corners = glm_vulkan::frustum_corners(cameraViewProjection());
+    auto planes = glm_vulkan::directional_shadow_caster_planes(corners, glm::vec3 { 0.0f, 1.0f, 0.0f });
+    auto spheres = Spheres {};
+    spheres.push(glm::vec3 { 0.0f, 0.0f, 5.0f }, 0.5f);
+    bool visible[1] = { false };
+
+    EXPECT_EQ(glm_vulkan::cull_spheres(planes.data(), planes.size(), spheres.view(), visible), 1);
+    EXPECT_TRUE(visible[0]);
+}
+
+TEST(ShadowCasterCullingTests, DirectionalLightKeepsCastersBetweenLightAndFrustum) {
+    auto corners = glm_vulkan::frustum_corners(cameraViewProjection());
+    auto planes = glm_vulkan::directional_shadow_caster_planes(corners, glm::vec3 { 0.0f, 1.0f, 0.0f });
+    auto spheres = Spheres {};
+    spheres.push(glm::vec3 { 0.0f, -100.0f, 5.0f }, 0.5f);
+    bool visible[1] = { false };
+
+    EXPECT_EQ(glm_vulkan::cull_spheres(planes.data(), planes.size(), spheres.view(), visible), 1);
+    EXPECT_TRUE(visible[0]);
+}
+
+TEST(ShadowCasterCullingTests, DirectionalLightCullsCastersBeyondFrustum) {
+    auto corners = glm_vulkan::frustum_corners(cameraViewProjection());
+    auto planes = glm_vulkan::directional_shadow_caster_planes(corners, glm::vec3 { 0.0f, 1.0f, 0.0f });
+    auto spheres = Spheres {};
+    spheres.push(glm::vec3 { 0.0f, 20.0f, 5.0f }, 0.5f);
+    spheres.push(glm::vec3 { 50.0f, -20.0f, 5.0f }, 0.5f);
+    spheres.push(glm::vec3 { 0.0f, -20.0f, 30.0f }, 0.5f);
+    bool visible[3] = { true, true, true };
+
+    EXPECT_EQ(glm_vulkan::cull_spheres(planes.data(), planes.size(), spheres.view(), visible), 0);
+    EXPECT_FALSE(visible[0]);
+    EXPECT_FALSE(visible[1]);
+    EXPECT_FALSE(visible[2]);
+}
+
+TEST(ShadowCasterCullingTests, DirectionalLightCullsBoxesUnderObliqueLight) {
+    auto corners = glm_vulkan::frustum_corners(cameraViewProjection());
+    auto planes = glm_vulkan::directional_shadow_caster_planes(corners, glm::vec3 { 0.3f, 1.0f, 0.2f });
+    auto boxes = Boxes {};
+    boxes.push(glm::vec3 { 0.0f, 0.0f, 5.0f }, glm::vec3 { 0.5f, 0.5f, 0.5f });
+    boxes.push(glm::vec3 { -30.0f, -100.0f, -15.0f }, glm::vec3 { 2.0f, 2.0f, 2.0f });
+    boxes.push(glm::vec3 { 0.0f, 20.0f, 5.0f }, glm::vec3 { 0.5f, 0.5f, 0.5f });
+    bool visible[3] = { false, false, true };
+
+    EXPECT_EQ(glm_vulkan::cull_aabbs(planes.data(), planes.size(), boxes.view(), visible), 2);
+    EXPECT_TRUE(visible[0]);
+    EXPECT_TRUE(visible[1]);
+    EXPECT_FALSE(visible[2]);
+}
+
+TEST(ShadowCasterCullingTests, DirectionalLightOverReceiverBoxKeepsOnlyCastersAboveIt) {
+    auto corners = glm_vulkan::aabb_corners(glm::vec3 { -1.0f, 0.0f, -1.0f }, glm::vec3 { 1.0f, 1.0f, 1.0f });
+    auto planes = glm_vulkan::directional_shadow_caster_planes(corners, glm::vec3 { 0.0f, 1.0f, 0.0f });
+    auto boxes = Boxes {};
+    boxes.push(glm::vec3 { 0.0f, -5.0f, 0.0f }, glm::vec3 { 0.5f, 0.5f, 0.5f });
+    boxes.push(glm::vec3 { 3.0f, -5.0f, 0.0f }, glm::vec3 { 0.5f, 0.5f, 0.5f });
+    boxes.push(glm::vec3 { 0.0f, 5.0f, 0.0f }, glm::vec3 { 0.5f, 0.5f, 0.5f });
+    bool visible[3] = { false, true, true };
+
+    EXPECT_EQ(glm_vulkan::cull_aabbs(planes.data(), planes.size(), boxes.view(), visible), 1);
+    EXPECT_TRUE(visible[0]);
+    EXPECT_FALSE(visible[1]);
+    EXPECT_FALSE(visible[2]);
+}
+
+TEST(ShadowCasterCullingTests, SpotLightKeepsCastersBetweenLightAndFrustum) {
+    auto corners = glm_vulkan::frustum_corners(cameraViewProjection());
+    auto lightPosition = glm::vec3 { 0.0f, -20.0f, 5.0f };
+    auto lightProjection = glm_vulkan::perspective_fov(glm::pi<float>() / 2.0f, 1.0f, 0.5f, 50.0f);
+    auto lightViewProjection = lightProjection * lightLookingDown(lightPosition);
+    auto planes = glm_vulkan::spot_shadow_caster_planes(corners, lightPosition, lightViewProjection);
+    auto spheres = Spheres {};
+    spheres.push(glm::vec3 { 0.0f, -10.0f, 5.0f }, 0.5f);
+    spheres.push(glm::vec3 { 0.0f, 0.0f, 5.0f }, 0.5f);
+    bool visible[2] = { false, false };
+
+    EXPECT_EQ(glm_vulkan::cull_spheres(planes.data(), planes.size(), spheres.view(), visible), 2);
+    EXPECT_TRUE(visible[0]);
+    EXPECT_TRUE(visible[1]);
+}
+
+TEST(ShadowCasterCullingTests, SpotLightCullsCastersOutsideHull) {
+    auto corners = glm_vulkan::frustum_corners(cameraViewProjection());
+    auto lightPosition = glm::vec3 { 0.0f, -20.0f, 5.0f };
+    auto lightProjection = glm_vulkan::perspective_fov(glm::pi<float>() / 2.0f, 1.0f, 0.5f, 50.0f);
+    auto lightViewProjection = lightProjection * lightLookingDown(lightPosition);
+    auto planes = glm_vulkan::spot_shadow_caster_planes(corners, lightPosition, lightViewProjection);
+    auto spheres = Spheres {};
+    spheres.push(glm::vec3 { 0.0f, -30.0f, 5.0f }, 0.5f);
+    spheres.push(glm::vec3 { 0.0f, -10.0f, 30.0f }, 0.5f);
+    spheres.push(glm::vec3 { 0.0f, 20.0f, 5.0f }, 0.5f);
+    bool visible[3] = { true, true, true };
+
+    EXPECT_EQ(glm_vulkan::cull_spheres(planes.data(), planes.size(), spheres.view(), visible), 0);
+    EXPECT_FALSE(visible[0]);
+    EXPECT_FALSE(visible[1]);
+    EXPECT_FALSE(visible[2]);
+}
@@ -0,0 +1,132 @@
+#include <glm_vulkan/glm_vulkan.h>
+#include <glm_vulkan/glm_vulkan_depth_precision.h>
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+
+static void print_usage(const char* program) {
+    std::fprintf(stderr,
+        "Usage: %s <perspective|orthographic> <near> <far> [relativeResolution [maxNear]]\n"
+        "\n"
+        "Prints the eye space depth resolution of each depth format at sample distances\n"
+        "between the near and far planes. When `relativeResolution` is given, also\n"
+        "recommends the cheapest depth format whose resolution at every sample distance\n"
+        "between `maxNear` and the far plane is at most `relativeResolution` times that\n"
+        "distance, moving the near plane out no farther than `maxNear`.\n",
+        program
+    );
+}
+
+static bool parse_float(const char* text, float& value) {
+    char* end = nullptr;
+    value = std::strtof(text, &end);
+
+    return end != text && *end == '\0' && std::isfinite(value);
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 4 || argc > 6) {
+        print_usage(argv[0]);
+        return 1;
+    }
+
+    glm_vulkan::ProjectionKind kind;
+    if (std::strcmp(argv[1], "perspective") == 0) {
+        kind = glm_vulkan::ProjectionKind::PERSPECTIVE;
+    } else if (std::strcmp(argv[1], "orthographic") == 0) {
+        kind = glm_vulkan::ProjectionKind::ORTHOGRAPHIC;
+    } else {
+        print_usage(argv[0]);
+        return 1;
+    }
+
+    float near = 0.0f;
+    float far = 0.0f;
+    if (!parse_float(argv[2], near) || !parse_float(argv[3], far) || !(0.0f < near && near < far)) {
+        std::fprintf(stderr, "error: expected 0 < near < far\n");
+        return 1;
+    }
+
+    float relativeResolution = 0.0f;
+    if (argc >= 5 && (!parse_float(argv[4], relativeResolution) || !(relativeResolution > 0.0f))) {
+        std::fprintf(stderr, "error: expected relativeResolution > 0\n");
+        return 1;
+    }
+
+    float maxNear = near;
+    if (argc >= 6 && (!parse_float(argv[5], maxNear) || !(near <= maxNear && maxNear < far))) {
+        std::fprintf(stderr, "error: expected near <= maxNear < far\n");
+        return 1;
+    }
+
+    glm::mat4x4 projection;
+    if (kind == glm_vulkan::ProjectionKind::PERSPECTIVE) {
+        projection = glm_vulkan::perspective_fov(glm::pi<float>() / 2.0f, 1.0f, near, far);
+    } else {
+        projection = glm_vulkan::orthographic_frustum(-1.0f, 1.0f, 1.0f, -1.0f, near, far);
+    }
+
+    // Perspective depth precision varies over orders of magnitude, so sample
+    // perspective ranges geometrically and orthographic ranges linearly.
+    auto sample_distances = [kind](float from, float to) {
+        constexpr std::size_t SAMPLE_COUNT = 12;
+        std::vector<float> distances;
+        for (std::size_t i = 0; i < SAMPLE_COUNT; i++) {
+            float t = static_cast<float>(i) / static_cast<float>(SAMPLE_COUNT - 1);
+            if (kind == glm_vulkan::ProjectionKind::PERSPECTIVE) {
+                distances.push_back(from * std::pow(to / from, t));
+            } else {
+                distances.push_back(from + (to - from) * t);
+            }
+        }
+        distances.back() = to;
+
+        return distances;
+    };
+
+    std::printf("%s projection, near = %g, far = %g\n", argv[1], near, far);
+    std::printf("eye space depth resolution by distance; reversed-Z leaves the UNORM storage step unchanged\n\n");
+    std::printf("%14s %14s %14s %14s %14s\n",
+        "distance", "D16_UNORM", "D24_UNORM", "D32_SFLOAT", "D32_SFLOAT rev"
+    );
+    for (float distance : sample_distances(near, far)) {
+        std::printf("%14.6g %14.6g %14.6g %14.6g %14.6g\n",
+            distance,
+            glm_vulkan::depth_resolution(projection, distance, glm_vulkan::DepthFormat::D16_UNORM, false),
+            glm_vulkan::depth_resolution(projection, distance, glm_vulkan::DepthFormat::D24_UNORM, false),
+            glm_vulkan::depth_resolution(projection, distance, glm_vulkan::DepthFormat::D32_SFLOAT, false),
+            glm_vulkan::depth_resolution(projection, distance, glm_vulkan::DepthFormat::D32_SFLOAT, true)
+        );
+    }
+
+    if (argc >= 5) {
+        // Nothing closer than `maxNear` needs to be visible, so the targets start there.
+        std::vector<glm_vulkan::DepthPrecisionTarget> targets;
+        for (float distance : sample_distances(maxNear, far)) {
+            targets.push_back(glm_vulkan::DepthPrecisionTarget { distance, relativeResolution * distance });
+        }
+
+        auto recommendation = glm_vulkan::recommend_depth_format(kind, near, far, maxNear, targets);
+        std::printf("\ntarget: resolution <= %g * distance, near <= %g\n", relativeResolution, maxNear);
+        if (recommendation.satisfied) {
+            std::printf("recommended: %s%s (%zu bytes per texel), near = %g\n",
+                glm_vulkan::depth_format_name(recommendation.format),
+                recommendation.reversedZ ? " reversed-Z" : "",
+                glm_vulkan::depth_format_bytes(recommendation.format),
+                recommendation.near
+            );
+        } else {
+            std::printf("no depth format meets the target; closest: %s%s, near = %g\n",
+                glm_vulkan::depth_format_name(recommendation.format),
+                recommendation.reversedZ ? " reversed-Z" : "",
+                recommendation.near
+            );
+        }
+    }
+
+    return 0;
+}